@@ -0,0 +1,143 @@
+#pragma once
+
+#ifndef _BITBOARDBFS_HPP_
+#define _BITBOARDBFS_HPP_
+
+#include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// \class BitboardBFS
+/// \brief Breadth First Search on a uniform grid which expands a whole wavefront per step.
+/// \details The free cells, the visited cells and the frontier are stored as bitboards, one bit per cell and one word per 8x8 tile,
+/// the bit (y % 8) * 8 + x % 8 of a tile is the cell (x, y). A step spreads the frontier to the four neighbours with shifts and masks,
+/// so every cell of the next wavefront is found at once. Four tiles next to each other form a block, only the blocks of the frontier
+/// and the blocks next to them are computed. Every tile row is padded with an empty tile on both sides and the board with an empty
+/// tile row above and below, so no bounds are checked.
+class BitboardBFS {
+public:
+	/// \brief Default constructor, creates an empty board.
+	BitboardBFS();
+
+	/// \brief Constructor to build the board of the free cells from a grid.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	explicit BitboardBFS(const Grid<CellState>& obstacles);
+
+	/// \brief Rebuild the board of the free cells from a grid, the search has to be started again.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	void setObstacles(const Grid<CellState>& obstacles);
+
+	/// \brief Start a new search, the start is the only visited cell and the first frontier.
+	/// \param start The starting cell.
+	void Start(const sf::Vector2i& start);
+
+	/// \brief Expand the frontier by one wavefront, the frontier becomes the cells which were reached for the first time.
+	/// \return The number of newly reached cells, 0 if the search is finished.
+	long long Step();
+
+	/// \brief Run the search from the start until every reachable cell is visited.
+	/// \param start The starting cell.
+	/// \param distances Resized to the grid, every reached cell gets its distance from the start, the other cells INT_MAX.
+	/// \return The number of reached cells including the start.
+	long long Run(const sf::Vector2i& start, Grid<int>& distances);
+
+	/// \brief Call a function for every cell of the current frontier.
+	/// \param function Called with the x and y coordinate of every cell.
+	template<typename Function>
+	void ForEachFrontierCell(Function function) const {
+		for (int block : active_blocks) {
+			int top = (block / blocks_per_row - 1) * 8;
+			int left = (block % blocks_per_row) * BLOCK_TILES * 8;
+			const uint64_t* tiles = &frontier[BlockOffset(block)];
+			for (int t = 0; t < BLOCK_TILES; t++) {
+				uint64_t tile = tiles[t];
+				while (tile != 0) {
+					int bit = CountTrailingZeros(tile);
+					function(left + t * 8 + bit % 8, top + bit / 8);
+					tile &= tile - 1;
+				}
+			}
+		}
+	}
+
+	/// \brief Check if a cell was reached by the search.
+	bool IsVisited(const int& x, const int& y) const;
+
+	/// \brief Get the distance of the current frontier from the start.
+	int getDepth() const;
+
+	/// \brief Get the number of cells in a row.
+	int getWidth() const;
+
+	/// \brief Get the number of rows.
+	int getHeight() const;
+
+	/// \brief Get the memory used by the bitboards and the block lists in bytes.
+	size_t getMemoryUsage() const;
+
+private:
+	static const int BLOCK_TILES = 4; ///< Number of tiles in a block, one AVX2 register.
+
+	/// \brief Get the index of the first tile of a block in the bitboards.
+	size_t BlockOffset(const int& block) const {
+		return static_cast<size_t>(block / blocks_per_row) * stride + 1 + (block % blocks_per_row) * BLOCK_TILES;
+	}
+
+	/// \brief Get the index of the tile of a cell in the bitboards.
+	size_t TileOffset(const int& x, const int& y) const {
+		return static_cast<size_t>(y / 8 + 1) * stride + 1 + x / 8;
+	}
+
+	/// \brief Add a block to the blocks computed in this step, unless it is already there.
+	void AddCandidate(const int& block);
+
+	/// \brief Compute the next wavefront of one block from the frontier of the block and of its neighbours.
+	/// \param block The index of the block.
+	/// \return The number of newly reached cells of the block.
+	long long ExpandBlock(const int& block);
+
+	/// \brief Count the set bits of a word.
+	static int PopCount(uint64_t word) {
+#if defined(_MSC_VER)
+		return static_cast<int>(__popcnt64(word));
+#else
+		return __builtin_popcountll(word);
+#endif
+	}
+
+	/// \brief Index of the lowest set bit of a nonzero word.
+	static int CountTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctzll(word);
+#endif
+	}
+
+	int width;                              ///< Number of cells in a row.
+	int height;                             ///< Number of rows.
+	int tile_rows;                          ///< Number of tile rows, without the padding.
+	int blocks_per_row;                     ///< Number of blocks covering a tile row.
+	int stride;                             ///< Number of tiles of a padded tile row.
+	int depth;                              ///< Distance of the current frontier from the start.
+
+	std::vector<uint64_t> free_cells;       ///< Bitboard of the cells which are not obstacles.
+	std::vector<uint64_t> visited;          ///< Bitboard of the cells reached by the search.
+	std::vector<uint64_t> frontier;         ///< Bitboard of the current wavefront, zero outside of the active blocks.
+	std::vector<uint64_t> next_frontier;    ///< Bitboard the next wavefront is built in.
+
+	std::vector<int> active_blocks;         ///< Blocks with a nonempty frontier.
+	std::vector<int> next_blocks;           ///< Blocks of the next wavefront.
+	std::vector<int> candidates;            ///< Blocks computed in the current step.
+	std::vector<unsigned char> candidate;   ///< Flag per block, set if the block is in candidates.
+};
+
+#endif
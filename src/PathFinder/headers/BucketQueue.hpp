@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef _BUCKETQUEUE_HPP_
+#define _BUCKETQUEUE_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \class BucketQueue
+/// \brief Monotone priority queue of cells with integer keys, one bucket per key (Dial's algorithm).
+/// \details Pushing and popping take constant time. The queue is monotone, a pushed key must not be smaller than the key
+/// of the last popped cell, which holds for Dijkstra's algorithm and for A* with a consistent heuristic. The buckets form
+/// a ring indexed by the key, the ring grows if a key is pushed further ahead of the smallest key than it can hold.
+/// The cells of one bucket are popped in the reverse order of the pushes, so A* continues from the cell reached last.
+class BucketQueue {
+public:
+	/// \brief Constructor, creates an empty queue.
+	BucketQueue();
+
+	/// \brief Remove every cell, the next pushed key becomes the smallest one.
+	void Clear();
+
+	/// \brief Add a cell to the queue.
+	/// \param key The key of the cell, at least the key of the last popped cell.
+	/// \param cell The index of the cell in the grid.
+	void Push(const int& key, const uint32_t& cell);
+
+	/// \brief Get the smallest key in the queue, the queue must not be empty.
+	int TopKey();
+
+	/// \brief Get a cell with the smallest key, the queue must not be empty.
+	uint32_t Top();
+
+	/// \brief Remove the cell returned by Top.
+	void Pop();
+
+	/// \brief Check if the queue is empty.
+	bool empty() const;
+
+	/// \brief Get the number of cells in the queue.
+	size_t size() const;
+
+private:
+	/// \brief Move the smallest key forward to the first nonempty bucket.
+	void FindTop();
+
+	/// \brief Double the ring until the keys from low to high fit, the buckets keep their keys.
+	void Grow(const int& low, const int& high);
+
+	std::vector<std::vector<uint32_t>> buckets;  ///< Ring of buckets, the bucket of the key k is buckets[k & mask].
+	int mask;                                    ///< Number of buckets minus one, the number of buckets is a power of two.
+	int top_key;                                 ///< The smallest key which can be in the queue, INT_MAX before the first push.
+	int max_key;                                 ///< The largest key pushed since the queue was last empty, no cell in the queue has a larger key.
+	size_t count;                                ///< Number of cells in the queue.
+};
+
+#endif
@@ -4,8 +4,8 @@
 #define _CELLSTATES_HPP_
 
 /// \enum CellState
-/// \brief Enum representing different states of a cell.
-enum CellState {
+/// \brief Enum representing different states of a cell, stored in a single byte so a grid of cells stays compact.
+enum CellState : unsigned char {
     Empty,          ///< Empty cell state, representing an empty space.
     Obstacle,       ///< Obstacle cell state, representing an impassable obstacle.
     Route,          ///< Route cell state, representing a cell that is part of a route.
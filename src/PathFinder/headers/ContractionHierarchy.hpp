@@ -0,0 +1,129 @@
+#pragma once
+
+#ifndef _CONTRACTIONHIERARCHY_HPP_
+#define _CONTRACTIONHIERARCHY_HPP_
+
+#include "../headers/MappedFile.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class WeightedGraph;
+
+#define CH_UNREACHED UINT32_MAX // Distance of the vertices a search did not reach, also the middle of an edge which is not a shortcut
+
+/// \struct HierarchyEdge
+/// \brief An edge of the contracted hierarchy, a shortcut stands for the two edges through its middle vertex.
+struct HierarchyEdge {
+	uint32_t vertex; ///< The vertex at the other end of the edge.
+	uint32_t weight; ///< The weight of the edge.
+	uint32_t middle; ///< The vertex the shortcut skips, CH_UNREACHED for an edge of the graph.
+};
+
+/// \class ContractionHierarchy
+/// \brief Contraction Hierarchies of a directed weighted graph, point-to-point queries only search a small upward part of it.
+/// \details The vertices are contracted one by one in the order of twice their edge difference (the shortcuts a contraction adds
+/// minus the edges it removes) plus the number of their contracted neighbours. Contracting a vertex adds a shortcut between two of its
+/// neighbours only if a witness search finds no path between them which is as short and avoids the vertex. A query runs Dijkstra's
+/// algorithm from the source on the edges to later contracted vertices and from the target on the reversed ones, the two searches
+/// meet at the top of the shortest path. A vertex which a higher vertex reaches on a shorter path is stalled and not expanded. The
+/// hierarchy is stored as two compressed arrays which are written to a file and mapped back without reading it.
+class ContractionHierarchy {
+public:
+	/// \brief Default constructor, an empty hierarchy.
+	ContractionHierarchy();
+
+	ContractionHierarchy(const ContractionHierarchy&) = delete;
+	ContractionHierarchy& operator=(const ContractionHierarchy&) = delete;
+
+	/// \brief Contract every vertex of a graph.
+	/// \param graph The graph, the weights must not be negative.
+	/// \return True if the hierarchy was built, otherwise false.
+	bool Build(const WeightedGraph& graph);
+
+	/// \brief Write the hierarchy to a binary file.
+	/// \param path The path of the file.
+	/// \return True if the file was written, otherwise false.
+	bool Save(const std::string& path) const;
+
+	/// \brief Map a file written by Save, the edges are read from the mapping.
+	/// \param path The path of the file.
+	/// \return True if the file was mapped and is valid, otherwise false.
+	bool Load(const std::string& path);
+
+	/// \brief Search the edges of another hierarchy, only the buffers of the queries are owned, so the threads can query one hierarchy
+	/// at the same time with one sharing hierarchy each.
+	/// \param hierarchy The hierarchy, it has to outlive this one and must not change while it is shared.
+	void Share(const ContractionHierarchy& hierarchy);
+
+	/// \brief Remove the hierarchy and close the mapped file.
+	void Clear();
+
+	/// \brief Find the length of the shortest path between two vertices.
+	/// \param source The vertex the path starts at.
+	/// \param target The vertex the path ends at.
+	/// \return The length of the path, -1 if the target cannot be reached.
+	long long Query(const int& source, const int& target);
+
+	/// \brief Find the shortest path between two vertices, the shortcuts are unpacked to the edges of the graph.
+	/// \param source The vertex the path starts at.
+	/// \param target The vertex the path ends at.
+	/// \return The vertices of the path from the source to the target, empty if the target cannot be reached.
+	std::vector<int> FindPath(const int& source, const int& target);
+
+	/// \brief Get the number of vertices of the hierarchy.
+	int getVertexCount() const;
+
+	/// \brief Get the number of upward edges, the shortcuts included.
+	size_t getEdgeCount() const;
+
+	/// \brief Get the number of shortcuts added by the contraction.
+	size_t getShortcutCount() const;
+
+	/// \brief Get the number of vertices settled by the two searches of the last query.
+	long long getExpansions() const;
+
+	/// \brief Get the bytes of the edges and of the buffers of the queries.
+	size_t getMemoryUsage() const;
+
+private:
+	/// \brief Run the two upward searches, sets meeting and the distances of the two sides.
+	/// \return The length of the shortest path, CH_UNREACHED if there is none.
+	uint32_t Search(const uint32_t& source, const uint32_t& target);
+
+	/// \brief Find the upward edge of a lower vertex to a higher one with the weight the search went along.
+	const HierarchyEdge* FindEdge(const uint32_t* begin, const HierarchyEdge* edges, const uint32_t& lower, const uint32_t& upper,
+		const uint32_t& weight) const;
+
+	/// \brief Append the vertices of an edge to a path, a shortcut is replaced by its two edges, the first vertex is not appended.
+	void UnpackEdge(const uint32_t& from, const uint32_t& to, const uint32_t& middle, std::vector<int>& path) const;
+
+	/// \brief Size the buffers of the queries for the vertices of the hierarchy.
+	void PrepareQueries();
+
+	/// \brief Point the edges into the owned storage.
+	void AttachStorage();
+
+	uint32_t vertex_count;                          ///< Number of vertices.
+	size_t forward_count;                           ///< Number of upward edges leaving the vertices.
+	size_t backward_count;                          ///< Number of upward edges entering the vertices.
+	size_t shortcut_count;                          ///< Number of shortcuts among the edges.
+
+	std::vector<uint32_t> owned_begins;             ///< Built edge offsets, the forward ones followed by the backward ones.
+	std::vector<HierarchyEdge> owned_edges;         ///< Built edges, the forward ones followed by the backward ones.
+	MappedFile file;                                ///< The loaded file, the edges point into it.
+	const uint32_t* forward_begin;                  ///< First upward edge leaving every vertex, vertex_count + 1 entries.
+	const HierarchyEdge* forward_edges;             ///< Edges to later contracted vertices, grouped by the vertex they leave.
+	const uint32_t* backward_begin;                 ///< First upward edge entering every vertex, vertex_count + 1 entries.
+	const HierarchyEdge* backward_edges;            ///< Edges from later contracted vertices, grouped by the vertex they enter.
+
+	std::vector<uint32_t> forward_distances;        ///< Distances of the search from the source.
+	std::vector<uint32_t> backward_distances;       ///< Distances of the search from the target on the reversed edges.
+	std::vector<uint32_t> forward_parents;          ///< Vertex which reached every vertex of the search from the source.
+	std::vector<uint32_t> backward_parents;         ///< Vertex which reached every vertex of the search from the target.
+	std::vector<uint32_t> touched;                  ///< Vertices reached by the last query, their distances are reset by the next one.
+	uint32_t meeting;                               ///< Vertex where the searches of the last query met on the shortest path.
+	long long expansions;                           ///< Vertices settled by the last query.
+};
+
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef _DISTANCEMATRIX_HPP_
+#define _DISTANCEMATRIX_HPP_
+
+#include <vector>
+#include <cstddef>
+
+class WeightedGraph;
+class ThreadPool;
+
+#define MATRIX_ROW_ALIGNMENT 8 // The rows are padded to a multiple of this many entries, eight distances fill one vector register
+#define FLOYD_WARSHALL_BLOCK 64 // Side of the blocks of Floyd-Warshall, three blocks of distances and hops stay in the L1 and L2 caches
+#define FLOYD_WARSHALL_LIMIT 2048 // Largest graph Build runs Floyd-Warshall on, larger graphs run Johnson's algorithm
+#define FLOYD_WARSHALL_DENSITY 32 // Build runs Floyd-Warshall if the edges are at least the square of the vertices divided by this
+
+/// \class DistanceMatrix
+/// \brief The distances between every pair of vertices of a weighted graph, a query reads one entry.
+/// \details The matrix is stored by rows, row s holds the distances from vertex s. Next to every distance the matrix keeps the
+/// vertex after the source on the shortest path, so a path is recovered one hop at a time without a search. The weights may be
+/// negative, a graph with a negative cycle has no matrix.
+class DistanceMatrix {
+public:
+	/// \brief Default constructor, an empty matrix.
+	DistanceMatrix();
+
+	/// \brief Find the distances with Floyd-Warshall for small dense graphs and with Johnson's algorithm for the others.
+	/// \details Floyd-Warshall takes the same time for every graph of a size, Johnson's algorithm is faster the fewer edges
+	/// the graph has. A graph is dense with at least n^2 / FLOYD_WARSHALL_DENSITY edges for n vertices.
+	/// \param graph The graph.
+	/// \param pool The threads to run on.
+	/// \param floyd_warshall_limit The largest number of vertices Floyd-Warshall is run on.
+	/// \return True if the matrix was built, false if the graph has a negative cycle or the matrix does not fit in memory.
+	bool Build(const WeightedGraph& graph, ThreadPool& pool, const int& floyd_warshall_limit = FLOYD_WARSHALL_LIMIT);
+
+	/// \brief Find the distances with Floyd-Warshall, block by block, on all threads of a pool.
+	/// \details The matrix is split into square blocks. For every block k on the diagonal, the block itself is relaxed first,
+	/// then the blocks in its row and its column through it and at last every other block through the row and the column, the
+	/// threads share the blocks of the last two steps. A block is relaxed with vectors of distances, a shorter distance takes the
+	/// next hop of the path to the middle vertex. Distances of 2^30 or more count as unreached, the ones below -2^30 are raised to it.
+	/// \param graph The graph.
+	/// \param pool The threads to run on.
+	/// \return True if the matrix was built, false if the graph has a negative cycle or the matrix does not fit in memory.
+	bool BuildFloydWarshall(const WeightedGraph& graph, ThreadPool& pool);
+
+	/// \brief Find the distances with Johnson's algorithm, on all threads of a pool.
+	/// \details Bellman-Ford from a virtual vertex with an edge of weight 0 to every vertex gives every vertex a potential h. The
+	/// edge from u to v weighs w + h(u) - h(v) after the reweighting, which is never negative, so Dijkstra's algorithm runs from
+	/// every vertex, the threads take the sources one by one. The reweighting adds h(s) - h(t) to every path from s to t, it is
+	/// subtracted again when the row is stored.
+	/// \param graph The graph.
+	/// \param pool The threads to run the searches on.
+	/// \return True if the matrix was built, false if the graph has a negative cycle or the matrix does not fit in memory.
+	bool BuildJohnson(const WeightedGraph& graph, ThreadPool& pool);
+
+	/// \brief Remove the matrix.
+	void Clear();
+
+	/// \brief Get the distance between two vertices.
+	/// \return The distance, INT_MAX if the target cannot be reached.
+	int getDistance(const int& from, const int& to) const;
+
+	/// \brief Get the vertex after the source on the shortest path between two vertices.
+	/// \return The vertex, the source itself if the two are the same, -1 if the target cannot be reached.
+	int getNextHop(const int& from, const int& to) const;
+
+	/// \brief Follow the next hops from the source to the target.
+	/// \return The vertices of the path from the source to the target, empty if the target cannot be reached.
+	std::vector<int> FindPath(const int& from, const int& to) const;
+
+	/// \brief Get the number of vertices.
+	int getVertexCount() const;
+
+	/// \brief Get the number of entries of a row, the vertex count padded to MATRIX_ROW_ALIGNMENT.
+	int getStride() const;
+
+	/// \brief Get the bytes of the two matrices.
+	size_t getMemoryUsage() const;
+
+private:
+	/// \brief Size the matrices for a number of vertices, every distance unreached.
+	/// \param vertices The number of vertices.
+	/// \param unreached The distance of the pairs which are not connected.
+	/// \return False if the matrices do not fit in memory.
+	bool Allocate(const int& vertices, const int& unreached);
+
+	int vertex_count;                  ///< Number of vertices.
+	int stride;                        ///< Entries of a row, the columns past the vertices are padding.
+	std::vector<int> distances;        ///< Distance between every pair, row by row, INT_MAX if the target is not reached.
+	std::vector<int> next_hops;        ///< Vertex after the source on every shortest path, -1 if the target is not reached.
+};
+
+#endif
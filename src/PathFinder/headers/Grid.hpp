@@ -0,0 +1,134 @@
+#pragma once
+
+#ifndef _GRID_HPP_
+#define _GRID_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+/// \class Grid
+/// \brief Contiguous row-major buffer of cells, used for every cell based map of the application.
+/// \details The cell (x, y) is stored at index y * stride + x, so walking along a row touches memory linearly.
+/// The indices are 32-bit, so a grid holds up to 2^32 - 1 cells and a cell id in a queue takes four bytes.
+template<typename T>
+class Grid {
+public:
+	/// \brief Default constructor, creates an empty grid.
+	Grid() : width(0), height(0), stride(0) {}
+
+	/// \brief Constructor to initialize the grid with the specified dimensions.
+	/// \param grid_width The number of cells in a row.
+	/// \param grid_height The number of rows.
+	/// \param value The value every cell is initialized to.
+	Grid(const int& grid_width, const int& grid_height, const T& value = T()) {
+		Resize(grid_width, grid_height, value);
+	}
+
+	/// \brief Resize the grid, every cell is set to the given value.
+	/// \param grid_width The number of cells in a row.
+	/// \param grid_height The number of rows.
+	/// \param value The value every cell is set to.
+	void Resize(const int& grid_width, const int& grid_height, const T& value = T()) {
+		width = grid_width;
+		height = grid_height;
+		stride = grid_width;
+		cells.assign(static_cast<size_t>(stride) * height, value);
+	}
+
+	/// \brief Set every cell of the grid to the given value without reallocating.
+	/// \param value The value to set.
+	void Fill(const T& value) {
+		if constexpr (sizeof(T) == 1) {
+			std::memset(cells.data(), static_cast<unsigned char>(value), cells.size());
+		}
+		else {
+			std::fill(cells.begin(), cells.end(), value);
+		}
+	}
+
+	/// \brief Get the index of a cell in the underlying buffer.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \return The index of the cell.
+	uint32_t Index(const int& x, const int& y) const {
+		return static_cast<uint32_t>(y) * static_cast<uint32_t>(stride) + static_cast<uint32_t>(x);
+	}
+
+	/// \brief Get the x-coordinate of a cell from its index.
+	int CellX(const uint32_t& index) const {
+		return static_cast<int>(index % static_cast<uint32_t>(stride));
+	}
+
+	/// \brief Get the y-coordinate of a cell from its index.
+	int CellY(const uint32_t& index) const {
+		return static_cast<int>(index / static_cast<uint32_t>(stride));
+	}
+
+	/// \brief Check if a cell lies inside the grid.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \return True if the cell is inside the grid, otherwise false.
+	bool InBounds(const int& x, const int& y) const {
+		return x >= 0 && y >= 0 && x < width && y < height;
+	}
+
+	/// \brief Access a cell by its coordinates.
+	T& operator()(const int& x, const int& y) {
+		return cells[Index(x, y)];
+	}
+
+	/// \brief Access a cell by its coordinates.
+	const T& operator()(const int& x, const int& y) const {
+		return cells[Index(x, y)];
+	}
+
+	/// \brief Access a cell by its index in the underlying buffer.
+	T& operator[](const uint32_t& index) {
+		return cells[index];
+	}
+
+	/// \brief Access a cell by its index in the underlying buffer.
+	const T& operator[](const uint32_t& index) const {
+		return cells[index];
+	}
+
+	/// \brief Get the number of cells in a row.
+	int getWidth() const {
+		return width;
+	}
+
+	/// \brief Get the number of rows.
+	int getHeight() const {
+		return height;
+	}
+
+	/// \brief Get the distance between the first cells of two neighbouring rows.
+	int getStride() const {
+		return stride;
+	}
+
+	/// \brief Get the number of cells stored in the buffer.
+	size_t getSize() const {
+		return cells.size();
+	}
+
+	/// \brief Get the underlying buffer.
+	T* getData() {
+		return cells.data();
+	}
+
+	/// \brief Get the underlying buffer.
+	const T* getData() const {
+		return cells.data();
+	}
+
+private:
+	int width;              ///< Number of cells in a row.
+	int height;             ///< Number of rows.
+	int stride;             ///< Distance between the first cells of two neighbouring rows.
+	std::vector<T> cells;   ///< The cells stored row after row.
+};
+
+#endif
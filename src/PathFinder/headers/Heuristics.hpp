@@ -0,0 +1,86 @@
+#pragma once
+
+#ifndef _HEURISTICS_HPP_
+#define _HEURISTICS_HPP_
+
+#include "../headers/Landmarks.hpp"
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+/// \enum HeuristicType
+/// \brief The distance estimated by a heuristic, it matches the moves allowed on the grid.
+enum class HeuristicType {
+	Manhattan, ///< Only straight moves, the estimate is straight_cost * (dx + dy).
+	Octile     ///< Straight and diagonal moves, the estimate is straight_cost * max(dx, dy) + (diagonal_cost - straight_cost) * min(dx, dy).
+};
+
+/// \class Heuristic
+/// \brief Integer estimate of the cost from a cell to a target cell, used by A*, Greedy Best-First Search and Jump Point Search.
+/// \details The costs are fixed-point integers, a diagonal move costs diagonal_cost / straight_cost straight moves, so the estimates
+/// are exact and the searches compare them without rounding. Both heuristics are written as
+/// straight_cost * (dx + dy) + min_factor * min(dx, dy), with min_factor 0 for Manhattan and diagonal_cost - 2 * straight_cost for octile,
+/// which lets the neighbours of a cell be estimated together with SSE4.1 or AVX2 when the project is compiled with them.
+/// The Manhattan distance can be raised to the landmark lower bounds of the cells (ALT), which also see the obstacles.
+class Heuristic {
+public:
+	/// \brief Constructor, the Manhattan distance with unit costs to the cell (0, 0).
+	Heuristic();
+
+	/// \brief Constructor.
+	/// \param type The distance to estimate.
+	/// \param straight_cost The cost of a straight move.
+	/// \param diagonal_cost The cost of a diagonal move, only used by the octile distance.
+	Heuristic(const HeuristicType& type, const int& straight_cost, const int& diagonal_cost = 0);
+
+	/// \brief Set the cell the cost is estimated to.
+	void setTarget(const sf::Vector2i& target);
+
+	/// \brief Get the cell the cost is estimated to.
+	const sf::Vector2i& getTarget() const;
+
+	/// \brief Get the distance the heuristic estimates.
+	HeuristicType getType() const;
+
+	/// \brief Use the lower bounds of landmarks built with the straight moves, only the Manhattan distance takes them.
+	/// \param landmarks The landmarks built for the grid, nullptr to stop using them.
+	/// \param stride The row length of the grid the landmarks were built for.
+	void setLandmarks(const Landmarks* landmarks, const int& stride);
+
+	/// \brief Estimate the cost from a cell to the target.
+	int Estimate(const int& x, const int& y) const {
+		int dx = std::abs(target.x - x);
+		int dy = std::abs(target.y - y);
+		int estimate = straight_cost * (dx + dy) + min_factor * std::min(dx, dy);
+		if (landmarks != nullptr) {
+			estimate = std::max(estimate, straight_cost * landmarks->LowerBound(static_cast<uint32_t>(y) * stride + x, target_index));
+		}
+		return estimate;
+	}
+
+	/// \brief Estimate the cost to the target of the neighbours of a cell at once.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \param dx The x offsets of the neighbours.
+	/// \param dy The y offsets of the neighbours.
+	/// \param count The number of neighbours.
+	/// \param estimates The estimate of every neighbour is written here.
+	void EstimateNeighbours(const int& x, const int& y, const int* dx, const int* dy, const int& count, int* estimates) const;
+
+private:
+	HeuristicType type;  ///< The distance to estimate.
+	int straight_cost;   ///< Cost of a straight move.
+	int min_factor;      ///< Added cost per diagonal move, 0 for the Manhattan distance.
+	sf::Vector2i target; ///< The cell the cost is estimated to.
+
+	const Landmarks* landmark_tables; ///< Landmarks set for the heuristic.
+	const Landmarks* landmarks;       ///< Landmarks raising the estimate, nullptr if there are none or none of them reaches the target.
+	int stride;                       ///< Row length of the grid of the landmarks.
+	uint32_t target_index;            ///< Index of the target in the tables of the landmarks.
+
+	/// \brief Use the landmark tables only if they give a bound to the target.
+	void AttachLandmarks();
+};
+
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef _HIERARCHICALGRAPH_HPP_
+#define _HIERARCHICALGRAPH_HPP_
+
+#include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+#define MAX_CLUSTER_SIZE 64 // A row of a cluster has to fit in the 64 bit masks of FloodCluster
+
+/// \class HierarchicalGraph
+/// \brief Hierarchical pathfinding (HPA*) on a 4-connected grid, long queries search a small abstract graph instead of every cell.
+/// \details The grid is split into square clusters. Where two clusters touch, every run of free cell pairs across the border is an
+/// entrance, a short run gets one transition in its middle and a long run one at each end. The cells of the transitions are the
+/// nodes of the abstract graph, the nodes of a cluster are connected by their distances inside the cluster and the two cells of a
+/// transition by a single move. A query connects the start and the end to the nodes of their clusters, runs A* on the abstract graph
+/// and then refines only the chosen segments with searches bounded to one cluster. The paths are near optimal, a segment never
+/// leaves its cluster. Changing a cell only marks its cluster, the borders of the marked clusters and the clusters next to them are
+/// rebuilt before the next query.
+class HierarchicalGraph {
+public:
+	/// \brief Default constructor, creates an empty graph.
+	HierarchicalGraph();
+
+	/// \brief Constructor to build the abstraction of a grid.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	/// \param cluster_size The side length of the clusters in cells, at most MAX_CLUSTER_SIZE.
+	explicit HierarchicalGraph(const Grid<CellState>& obstacles, const int& cluster_size = 16);
+
+	/// \brief Rebuild the whole abstraction for a new grid.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	/// \param cluster_size The side length of the clusters in cells, at most MAX_CLUSTER_SIZE.
+	void setObstacles(const Grid<CellState>& obstacles, const int& cluster_size = 16);
+
+	/// \brief Change one cell, only its cluster and the clusters next to it are rebuilt before the next query.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \param state The new state of the cell.
+	void setCell(const int& x, const int& y, const CellState& state);
+
+	/// \brief Find a path between two cells, the clusters changed since the last query are rebuilt first.
+	/// \param start The starting cell.
+	/// \param end The ending cell.
+	/// \return The cells of the path from the start to the end, empty if there is none.
+	std::vector<sf::Vector2i> FindPath(const sf::Vector2i& start, const sf::Vector2i& end);
+
+	/// \brief Get the side length of the clusters.
+	int getClusterSize() const;
+
+	/// \brief Get the number of nodes of the abstract graph.
+	int getAbstractNodeCount() const;
+
+	/// \brief Get the number of abstract nodes and cells expanded by the last query.
+	long long getExpansions() const;
+
+	/// \brief Get the number of clusters rebuilt since the graph was created.
+	long long getRebuiltClusters() const;
+
+	/// \brief Get the bytes used by the grid and the abstraction.
+	size_t getMemoryUsage() const;
+
+private:
+	/// \struct Cluster
+	/// \brief The abstract nodes of one cluster and the distances between them.
+	struct Cluster {
+		std::vector<uint32_t> nodes;                  ///< Cells of the abstract nodes in the cluster.
+		std::vector<int> distances;                   ///< Distance between every pair of nodes inside the cluster, row major, -1 if not connected.
+		std::vector<std::vector<uint32_t>> crossings; ///< Cells in the other clusters every node reaches with one move.
+	};
+
+	/// \brief Get the index of the cluster of a cell.
+	int ClusterOf(const int& x, const int& y) const;
+
+	/// \brief Check if a cell is inside the grid and is not an obstacle.
+	bool IsFree(const int& x, const int& y) const;
+
+	/// \brief Find the transitions of the border on the right (east) or below (south) a cluster.
+	void BuildBorder(const int& cluster, const bool& east);
+
+	/// \brief Collect the nodes of a cluster from its four borders and compute the distances between them.
+	void BuildCluster(const int& cluster);
+
+	/// \brief Rebuild the marked clusters, their borders and the clusters sharing these borders.
+	void Rebuild();
+
+	/// \brief Copy the free cells of a cluster into local_free, the searches of SearchCluster stay inside it.
+	void LoadCluster(const int& cluster);
+
+	/// \brief Breadth First Search from a cell of the loaded cluster, fills local_distances and local_parents.
+	/// \return The number of expanded cells.
+	long long SearchCluster(const uint32_t& source);
+
+	/// \brief Distances from a cell of the loaded cluster to other cells of it, one flood of the row masks per distance.
+	/// \param source The local position of the source.
+	/// \param targets The local positions of the targets, the flood stops when all of them are reached.
+	/// \param count The number of targets.
+	/// \param distances The output for every target, -1 for the targets not reached.
+	void FloodCluster(const sf::Vector2i& source, const sf::Vector2i* targets, const size_t& count, int* distances);
+
+	/// \brief Get the index of a cell of the loaded cluster in the local buffers, -1 if it is outside of the cluster.
+	int LocalIndex(const uint32_t& cell) const;
+
+	/// \brief Get the index of a node in the list of its cluster, -1 if the cell is not a node.
+	int NodeIndex(const int& cluster, const uint32_t& cell) const;
+
+	Grid<CellState> cells;                            ///< The grid the abstraction is built for.
+	int cluster_size;                                 ///< Side length of the clusters.
+	int clusters_x;                                   ///< Number of clusters in a row.
+	int clusters_y;                                   ///< Number of clusters in a column.
+	std::vector<Cluster> clusters;                    ///< The clusters, row major.
+	std::vector<std::vector<std::pair<uint32_t, uint32_t>>> borders;  ///< Transitions of the east (2 * cluster) and south (2 * cluster + 1) border of every cluster, the first cell is in the cluster.
+	std::vector<unsigned char> dirty;                 ///< Flag of every cluster changed since the last rebuild.
+	bool any_dirty;                                   ///< Flag indicating if any cluster has to be rebuilt.
+
+	int search_x;                                     ///< Left column of the loaded cluster.
+	int search_y;                                     ///< Top row of the loaded cluster.
+	int local_stride;                                 ///< Row length of the local buffers, the cluster is padded with a blocked cell on every side.
+	std::vector<unsigned char> local_free;            ///< Free cells of the loaded cluster, the padding and the cells outside of the grid are blocked.
+	std::vector<uint64_t> free_rows;                  ///< Free cells of every row of the loaded cluster as bits, padded with an empty row above and below.
+	std::vector<uint64_t> flood_visited;              ///< Cells reached by FloodCluster, same layout as free_rows.
+	std::vector<uint64_t> flood_frontier;             ///< Cells reached in the last step of FloodCluster.
+	std::vector<uint64_t> flood_next;                 ///< Cells reached in the current step of FloodCluster.
+	std::vector<uint64_t> flood_targets;              ///< Targets of FloodCluster not reached yet.
+	std::vector<int> local_distances;                 ///< Distances of the last SearchCluster, -1 for the cells not reached.
+	std::vector<unsigned char> local_parents;         ///< Direction of the move which reached every cell in the last SearchCluster.
+	std::vector<int> local_queue;                     ///< Queue of SearchCluster, local indices.
+
+	long long expansions;                             ///< Abstract nodes and cells expanded by the last query.
+	long long rebuilt_clusters;                       ///< Number of clusters rebuilt since the graph was created.
+};
+
+#endif
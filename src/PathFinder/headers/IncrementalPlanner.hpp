@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef _INCREMENTALPLANNER_HPP_
+#define _INCREMENTALPLANNER_HPP_
+
+#include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include "../headers/Heuristics.hpp"
+#include "../headers/UnweightedGraph.hpp"
+#include <vector>
+#include <queue>
+#include <functional>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+/// \struct PlannerKey
+/// \brief A cell queued by the incremental planner with the key it was queued with, the keys are compared lexicographically.
+struct PlannerKey {
+	int primary;     ///< min(g, rhs) + the estimate from the start + the key modifier.
+	int secondary;   ///< min(g, rhs).
+	uint32_t cell;   ///< Index of the cell.
+
+	bool operator>(const PlannerKey& other) const {
+		return primary != other.primary ? primary > other.primary : secondary > other.secondary;
+	}
+
+	bool operator<(const PlannerKey& other) const {
+		return other > *this;
+	}
+};
+
+/// \class IncrementalPlanner
+/// \brief D* Lite on a grid, the shortest path is repaired after the obstacles change instead of being searched again.
+/// \details The search runs backwards from the end. Every cell keeps its distance to the end g and a one step lookahead rhs, the
+/// minimum over its neighbours of the move cost plus their g. A cell whose g and rhs differ is queued, ComputeShortestPath expands
+/// the queued cells by their keys until the start is settled, so after an edit only the cells whose distance changed are expanded
+/// again. With a fixed start this is Lifelong Planning A* searching from the end. A moving agent sets the start to its new cell,
+/// the estimates are taken from the new start and the key modifier grows by the distance moved, so the queued keys stay valid.
+/// The moves and their fixed-point costs are the ones of UnweightedGraph.
+class IncrementalPlanner {
+public:
+	/// \brief Default constructor, an empty grid with straight moves.
+	IncrementalPlanner();
+
+	/// \brief Plan on a new grid, the search starts over.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	void setObstacles(const Grid<CellState>& obstacles);
+
+	/// \brief Set the moves allowed on the grid, the search starts over.
+	/// \param moves The moves allowed on the grid.
+	/// \param corners When a diagonal move may pass next to an obstacle.
+	void setConnectivity(const Connectivity& moves, const CornerCutting& corners = CornerCutting::Forbid);
+
+	/// \brief Move the start, the distances to the end are kept.
+	void setStart(const sf::Vector2i& cell);
+
+	/// \brief Set the end, the search starts over.
+	void setEnd(const sf::Vector2i& cell);
+
+	/// \brief Change one cell, the cell and its neighbours look ahead again and are queued if their distance may have changed.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \param state The new state of the cell, only obstacles block it.
+	void UpdateCell(const int& x, const int& y, const CellState& state);
+
+	/// \brief Expand the queued cells until the distance of the start is known.
+	/// \return True if the end can be reached from the start.
+	bool ComputeShortestPath();
+
+	/// \brief Follow the cheapest moves from the start to the end, ComputeShortestPath has to be called after the last change.
+	/// \return The cells of the path from the start to the end, empty if the end cannot be reached.
+	std::vector<sf::Vector2i> FindPath() const;
+
+	/// \brief Get the distance from the start to the end, a fixed-point multiple of the straight cost, INT_MAX if it cannot be reached.
+	int getDistance() const;
+
+	/// \brief Get the cost of a straight move, 1 for the straight moves only and 70 with the diagonal moves.
+	int getStraightCost() const;
+
+	/// \brief Get the number of cells expanded by the last ComputeShortestPath.
+	long long getExpansions() const;
+
+	/// \brief Get the start.
+	const sf::Vector2i& getStart() const;
+
+	/// \brief Get the end.
+	const sf::Vector2i& getEnd() const;
+
+	/// \brief Get the bytes of the grids and of the queue.
+	size_t getMemoryUsage() const;
+
+private:
+	/// \brief Forget every distance and queue the end.
+	void Restart();
+
+	/// \brief Get the cost of a move from a cell to its neighbour in a direction.
+	/// \return The cost, INT_MAX if the neighbour is outside of the grid, one of the cells is an obstacle or the move cuts a corner.
+	int MoveCost(const int& x, const int& y, const int& direction) const;
+
+	/// \brief Get the lowest move cost plus g over the neighbours of a cell.
+	int LookAhead(const uint32_t& cell) const;
+
+	/// \brief Get the key of a cell from its g and rhs.
+	PlannerKey CalculateKey(const uint32_t& cell) const;
+
+	/// \brief Queue a cell if its g and rhs differ, the entries of settled cells are skipped when they are taken from the queue.
+	void UpdateVertex(const uint32_t& cell);
+
+	Grid<CellState> obstacles;                  ///< The cells, only obstacles block a move.
+	Grid<int> g_values;                         ///< Distance of every cell to the end found so far, INT_MAX if unknown.
+	Grid<int> rhs_values;                       ///< Lowest move cost plus g over the neighbours of every cell, 0 for the end.
+	std::priority_queue<PlannerKey, std::vector<PlannerKey>, std::greater<PlannerKey>> open;  ///< Cells whose g and rhs differ, may hold outdated entries.
+	Heuristic heuristic;                        ///< Estimate of the distance to the start.
+
+	sf::Vector2i start;                         ///< The cell the path starts from.
+	sf::Vector2i end;                           ///< The cell the search starts from.
+	sf::Vector2i last_start;                    ///< The start when the key modifier was last raised.
+	int key_modifier;                           ///< Sum of the distances the start moved, added to the keys queued after a move.
+	Connectivity connectivity;                  ///< The moves allowed on the grid.
+	CornerCutting corner_cutting;               ///< When a diagonal move may pass next to an obstacle.
+	int straight_cost;                          ///< Cost of a straight move.
+	long long expansions;                       ///< Cells expanded by the last ComputeShortestPath.
+};
+
+#endif
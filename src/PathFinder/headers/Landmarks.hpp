@@ -0,0 +1,165 @@
+#pragma once
+
+#ifndef _LANDMARKS_HPP_
+#define _LANDMARKS_HPP_
+
+#include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include "../headers/MappedFile.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+class WeightedGraph;
+
+#define UNREACHED_DISTANCE UINT32_MAX // Distance stored in the tables for the vertices a landmark does not reach
+
+/// \enum LandmarkSelection
+/// \brief How the landmarks are placed.
+enum class LandmarkSelection {
+	Farthest, ///< Every landmark is the vertex farthest from the landmarks chosen before it.
+	Avoid     ///< Every landmark is the leaf of the shortest path tree of a random root whose subtree the chosen landmarks bound worst.
+};
+
+/// \class Landmarks
+/// \brief Distance tables of a few landmark vertices, their differences are lower bounds for A* (ALT).
+/// \details By the triangle inequality d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L) for every landmark L, the largest
+/// of these differences is an admissible and consistent estimate. Unlike the geometric heuristics it knows the walls, so in mazes A*
+/// expands far fewer cells. Every landmark costs one table of 4 bytes per vertex (two for directed graphs), the tables are stored
+/// vertex by vertex so the bounds of a vertex are read from one cache line. The tables can be saved to a file and mapped back
+/// without reading it.
+class Landmarks {
+public:
+	/// \brief Default constructor, no landmarks.
+	Landmarks();
+
+	Landmarks(const Landmarks&) = delete;
+	Landmarks& operator=(const Landmarks&) = delete;
+
+	/// \brief Place landmarks on a grid with straight moves and compute their distance tables, the vertices are the cell indices.
+	/// \param obstacles The grid, every cell which is not an obstacle is free.
+	/// \param count The number of landmarks.
+	/// \param selection How the landmarks are placed.
+	/// \return True if the tables were built, otherwise false.
+	bool Build(const Grid<CellState>& obstacles, const int& count, const LandmarkSelection& selection = LandmarkSelection::Farthest);
+
+	/// \brief Place landmarks on a directed weighted graph and compute the distance tables to and from them.
+	/// \param graph The graph, the weights must not be negative.
+	/// \param count The number of landmarks.
+	/// \param selection How the landmarks are placed.
+	/// \return True if the tables were built, otherwise false.
+	bool Build(const WeightedGraph& graph, const int& count, const LandmarkSelection& selection = LandmarkSelection::Farthest);
+
+	/// \brief Write the landmarks and their tables to a binary file.
+	/// \param path The path of the file.
+	/// \return True if the file was written, otherwise false.
+	bool Save(const std::string& path) const;
+
+	/// \brief Map a file written by Save for a grid, the tables are read from the mapping.
+	/// \param path The path of the file.
+	/// \param obstacles The grid the tables must have been built for, a file of another size or other obstacles is rejected.
+	/// \return True if the file was mapped, is valid and belongs to the grid, otherwise false.
+	bool Load(const std::string& path, const Grid<CellState>& obstacles);
+
+	/// \brief Map a file written by Save for a weighted graph, the tables are read from the mapping.
+	/// \param path The path of the file.
+	/// \param graph The graph the tables must have been built for, a file of another graph is rejected.
+	/// \return True if the file was mapped, is valid and belongs to the graph, otherwise false.
+	bool Load(const std::string& path, const WeightedGraph& graph);
+
+	/// \brief Check if the tables were built for a grid of the same size and obstacles, only then are their bounds admissible.
+	bool Matches(const Grid<CellState>& obstacles) const;
+
+	/// \brief Check if the tables were built for a graph with the same vertices and edges.
+	bool Matches(const WeightedGraph& graph) const;
+
+	/// \brief Remove the landmarks and close the mapped file.
+	void Clear();
+
+	/// \brief Get the lower bound of the distance between two vertices.
+	/// \param from The vertex the distance is measured from.
+	/// \param to The vertex the distance is measured to.
+	int LowerBound(const uint32_t& from, const uint32_t& to) const {
+		const uint32_t* from_forward = forward + static_cast<size_t>(from) * count;
+		const uint32_t* to_forward = forward + static_cast<size_t>(to) * count;
+		uint32_t bound = 0;
+		if (!directed) {
+			// The two differences of an undirected graph are one absolute difference
+			for (int i = 0; i < count; i++) {
+				if (from_forward[i] != UNREACHED_DISTANCE && to_forward[i] != UNREACHED_DISTANCE) {
+					bound = std::max(bound, from_forward[i] < to_forward[i] ? to_forward[i] - from_forward[i] : from_forward[i] - to_forward[i]);
+				}
+			}
+			return static_cast<int>(bound);
+		}
+		const uint32_t* from_backward = backward + static_cast<size_t>(from) * count;
+		const uint32_t* to_backward = backward + static_cast<size_t>(to) * count;
+		for (int i = 0; i < count; i++) {
+			if (to_forward[i] != UNREACHED_DISTANCE && from_forward[i] < to_forward[i]) {
+				bound = std::max(bound, to_forward[i] - from_forward[i]);
+			}
+			if (from_backward[i] != UNREACHED_DISTANCE && to_backward[i] < from_backward[i]) {
+				bound = std::max(bound, from_backward[i] - to_backward[i]);
+			}
+		}
+		return static_cast<int>(bound);
+	}
+
+	/// \brief Check if a vertex is reached from or reaches any landmark, the lower bounds to the other vertices are zero.
+	bool Reaches(const uint32_t& vertex) const;
+
+	/// \brief Get the number of landmarks.
+	int getCount() const;
+
+	/// \brief Get the number of vertices the tables were built for, the size of the grid including its padding.
+	uint32_t getVertexCount() const;
+
+	/// \brief Get the width of the grid the tables were built for, the cell (x, y) is the vertex y * width + x. The number of vertices for a graph.
+	uint32_t getWidth() const;
+
+	/// \brief Get the landmark vertices.
+	const std::vector<uint32_t>& getLandmarks() const;
+
+	/// \brief Check if the tables were built for a directed graph, with separate tables to the landmarks.
+	bool isDirected() const;
+
+	/// \brief Get the bytes of the tables, mapped or owned.
+	size_t getMemoryUsage() const;
+
+private:
+	/// \brief Fills the distances from (or to, when reverse) a source, the parents in the shortest path tree and the order the vertices were settled in.
+	typedef std::function<void(const uint32_t& source, const bool& reverse, std::vector<uint32_t>& distances, std::vector<uint32_t>& parents, std::vector<uint32_t>& order)> Search;
+
+	/// \brief Place the landmarks one by one and fill their tables.
+	/// \param candidates The vertices a landmark or a root may be placed on.
+	/// \param search The shortest path search of the graph.
+	void Select(const std::vector<uint32_t>& candidates, const LandmarkSelection& selection, const Search& search);
+
+	/// \brief Point the tables into the owned storage.
+	void AttachStorage();
+
+	/// \brief Map a file written by Save without checking which map it belongs to.
+	bool Map(const std::string& path);
+
+	/// \brief Hash the size and the obstacles of a grid.
+	static uint64_t Fingerprint(const Grid<CellState>& obstacles);
+
+	/// \brief Hash the vertex count and the edges of a graph, in any order of the edges.
+	static uint64_t Fingerprint(const WeightedGraph& graph);
+
+	uint32_t vertex_count;                    ///< Number of vertices of the tables.
+	uint32_t width;                           ///< Width of the grid of the tables, the number of vertices for a graph.
+	uint32_t height;                          ///< Height of the grid of the tables, 1 for a graph.
+	uint64_t fingerprint;                     ///< Hash of the obstacles or the edges the tables were built for.
+	int count;                                ///< Number of landmarks.
+	bool directed;                            ///< Flag indicating if the backward tables differ from the forward ones.
+	std::vector<uint32_t> landmark_vertices;  ///< The landmarks.
+	std::vector<uint32_t> storage;            ///< The built tables, the forward tables followed by the backward ones for directed graphs.
+	MappedFile file;                          ///< The loaded file, the tables point into it.
+	const uint32_t* forward;                  ///< Distance from every landmark to every vertex, vertex by vertex.
+	const uint32_t* backward;                 ///< Distance from every vertex to every landmark, the forward tables for undirected graphs.
+};
+
+#endif
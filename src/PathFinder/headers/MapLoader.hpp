@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef _MAPLOADER_HPP_
+#define _MAPLOADER_HPP_
+
+#include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include "../headers/WeightedGraph.hpp"
+#include <string>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+class ThreadPool;
+
+#define LOADER_BYTES_PER_LINE 16 // Expected length of a line of a graph file, the parsed lines are reserved for it
+#define LOADER_RANGES_PER_THREAD 16 // Parts of the vertices per worker, the edges are sorted into them before they are packed
+#define LOADER_MAX_VERTICES (1 << 28) // Most vertices of a graph file, ten times the largest road network, a higher vertex id is a broken line
+
+/// \struct ScenarioQuery
+/// \brief A query of a MovingAI scenario file, with the length of its optimal path.
+struct ScenarioQuery {
+	int bucket;              ///< The bucket of the query, the queries of a bucket have optimal lengths of about the same size.
+	std::string map;         ///< The map file named by the scenario.
+	int width;               ///< The width of the map.
+	int height;              ///< The height of the map.
+	sf::Vector2i start;      ///< The starting cell.
+	sf::Vector2i end;        ///< The ending cell.
+	double optimal_length;   ///< The length of the optimal path with straight moves of 1 and diagonal moves of sqrt(2).
+};
+
+/// \class MapLoader
+/// \brief Class for loading grids and weighted graphs from text files, so they can be solved without the window.
+/// \details The graph files are mapped into memory and split into one part per worker of a pool at line breaks. Every worker
+/// reads the numbers of its part into a list of edges, then the edges are sorted by the range of vertices they leave and every
+/// worker packs the rows of its ranges, the edges of a vertex keep the order of the file.
+class MapLoader {
+public:
+	/// \brief Load a grid from a text file.
+	/// \details Every line of the file is a row of the grid, '.' is an empty cell, '#' or '@' is an obstacle,
+	/// 'S' and 'E' mark the start and the end. Lines starting with ';' are comments.
+	/// \param path The path of the file.
+	/// \param grid The grid to fill.
+	/// \param start Set to the cell marked 'S', left untouched if there is none.
+	/// \param end Set to the cell marked 'E', left untouched if there is none.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadGrid(const std::string& path, Grid<CellState>& grid, sf::Vector2i& start, sf::Vector2i& end);
+
+	/// \brief Load a grid from a MovingAI map file (.map).
+	/// \details The header gives the height and the width, the rows follow the line "map". The cells '.', 'G' and 'S' (swamp)
+	/// are free, '@', 'O', 'T' (trees) and 'W' (water) are obstacles.
+	/// \param path The path of the file.
+	/// \param grid The grid to fill.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadMovingAIMap(const std::string& path, Grid<CellState>& grid);
+
+	/// \brief Load the queries of a MovingAI scenario file (.scen).
+	/// \details After the line "version 1" every line is a query "bucket map width height start_x start_y end_x end_y optimal_length".
+	/// \param path The path of the file.
+	/// \param queries The queries, in the order of the file.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadMovingAIScenario(const std::string& path, std::vector<ScenarioQuery>& queries);
+
+	/// \brief Load a weighted graph from an edge list file.
+	/// \details Every line is an edge "from to weight" with vertices numbered from 0, lines starting with '#' are comments.
+	/// The graph has as many vertices as the highest vertex number plus one.
+	/// \param path The path of the file.
+	/// \param graph The graph, its vertices and edges are replaced.
+	/// \param pool The threads to read the file on.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadEdgeList(const std::string& path, WeightedGraph& graph, ThreadPool& pool);
+
+	/// \brief Load a weighted graph from a DIMACS shortest path file (.gr).
+	/// \details The line "p sp n m" gives the number of vertices, every line "a u v w" is an edge with vertices numbered from 1,
+	/// lines starting with 'c' are comments. The vertices are numbered from 0 in the graph.
+	/// \param path The path of the file.
+	/// \param graph The graph, its vertices and edges are replaced.
+	/// \param pool The threads to read the file on.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadDimacs(const std::string& path, WeightedGraph& graph, ThreadPool& pool);
+
+	/// \brief Load the coordinates of the vertices from a DIMACS coordinate file (.co).
+	/// \details The line "p aux sp co n" gives the number of vertices, every line "v id x y" is the position of a vertex
+	/// numbered from 1, lines starting with 'c' are comments.
+	/// \param path The path of the file.
+	/// \param coordinates Set to the position of every vertex numbered from 0, (0, 0) for the vertices without a line.
+	/// \param pool The threads to read the file on.
+	/// \return True if the file was loaded, otherwise false.
+	static bool LoadDimacsCoordinates(const std::string& path, std::vector<sf::Vector2i>& coordinates, ThreadPool& pool);
+};
+
+#endif
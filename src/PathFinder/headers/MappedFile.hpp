@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef _MAPPEDFILE_HPP_
+#define _MAPPEDFILE_HPP_
+
+#include <string>
+#include <cstddef>
+
+/// \class MappedFile
+/// \brief A file mapped read-only into memory, the pages are loaded by the operating system when they are first read.
+/// \details Large preprocessed tables are read straight from the mapping instead of being copied, so opening them costs nothing
+/// until they are used and the pages can be shared by several processes.
+class MappedFile {
+public:
+	/// \brief Default constructor, no file is mapped.
+	MappedFile();
+
+	/// \brief Destructor, unmaps the file.
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// \brief Map a whole file, the previous mapping is closed first.
+	/// \param path The path of the file.
+	/// \return True if the file was mapped, otherwise false.
+	bool Open(const std::string& path);
+
+	/// \brief Unmap the file.
+	void Close();
+
+	/// \brief Check if a file is mapped.
+	bool isOpen() const;
+
+	/// \brief Get the first byte of the mapping, nullptr if no file is mapped.
+	const char* getData() const;
+
+	/// \brief Get the size of the mapped file in bytes.
+	size_t getSize() const;
+
+private:
+	const char* data;     ///< The first byte of the mapping.
+	size_t size;          ///< The size of the file.
+#if defined(_WIN32)
+	void* file_handle;    ///< Handle of the opened file.
+	void* mapping_handle; ///< Handle of the file mapping object.
+#else
+	int descriptor;       ///< Descriptor of the opened file.
+#endif
+};
+
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef _QUERYSERVER_HPP_
+#define _QUERYSERVER_HPP_
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class ThreadPool;
+
+#define SERVER_QUEUE_LIMIT 4096 // Requests waiting for a worker, the reading stops until the workers took some of them
+#define SERVER_READ_SIZE 65536 // Bytes read from a client at once
+#define SERVER_MAX_LINE (1 << 20) // Longest request, a client sending a longer line is disconnected
+#define SERVER_POLL_INTERVAL 200 // Milliseconds between two checks whether the server was asked to stop
+
+/// \class QueryServer
+/// \brief Answers requests, one per line, from the standard input or from the clients of a Unix domain socket on the workers of a pool.
+/// \details One thread reads the lines of every client and queues them, the workers of the pool take the requests from the queue
+/// and write every answer as one line to the client which sent the request. A client may send many requests without waiting for
+/// the answers, they are answered as soon as a worker is free, so the answers may come back in another order than the requests.
+class QueryServer {
+public:
+	/// \brief Answers one request on a worker, the line break is not part of the request nor of the answer.
+	using Handler = std::function<std::string(const int& worker, const std::string& request)>;
+
+	/// \brief Constructor.
+	/// \param pool The workers which answer the requests, the server runs one job on them until it stops.
+	explicit QueryServer(ThreadPool& pool);
+
+	QueryServer(const QueryServer&) = delete;
+	QueryServer& operator=(const QueryServer&) = delete;
+
+	/// \brief Answer the lines of the standard input on the standard output until the input ends.
+	/// \param handler Answers a request, called on the workers of the pool at the same time.
+	void ServeStandardStreams(const Handler& handler);
+
+	/// \brief Listen on a Unix domain socket and answer its clients until SIGINT or SIGTERM, the socket file is removed at the end.
+	/// \param path The path of the socket, a socket left at the path by an earlier server is replaced.
+	/// \param handler Answers a request, called on the workers of the pool at the same time.
+	/// \return False if the socket could not be created.
+	bool ServeSocket(const std::string& path, const Handler& handler);
+
+	/// \brief Get the number of requests answered.
+	long long getAnswered() const;
+
+private:
+	/// \struct Client
+	/// \brief A connection the requests came from, closed when the last of its requests was answered.
+	struct Client {
+		int descriptor;       ///< Socket of the client, -1 for the standard output.
+		std::mutex writing;   ///< Keeps the answers of two workers from mixing.
+		bool broken;          ///< True after a write failed, the answers left are dropped.
+
+		explicit Client(const int& descriptor);
+		~Client();
+
+		/// \brief Write an answer and a line break.
+		void Write(const std::string& answer);
+	};
+
+	/// \struct Request
+	/// \brief A line and the client which sent it.
+	struct Request {
+		std::shared_ptr<Client> client;  ///< The client the answer is written to.
+		std::string line;                ///< The request.
+	};
+
+	/// \brief Queue a request, waits while SERVER_QUEUE_LIMIT requests are queued.
+	void Push(const std::shared_ptr<Client>& client, std::string&& line);
+
+	/// \brief Take the next request, waits until one is queued or the server stops.
+	/// \return False if the server stopped and every request was taken.
+	bool Pop(Request& request);
+
+	/// \brief Stop taking requests, the queued ones are still answered.
+	void Stop();
+
+	/// \brief Answer the queued requests on every worker of the pool until the server stops, the reader runs on its own thread meanwhile.
+	/// \param reader Reads the requests and queues them, the server stops when it returns.
+	void Run(const std::function<void()>& reader, const Handler& handler);
+
+	ThreadPool& pool;                    ///< The workers.
+	std::mutex mutex;                    ///< Guards the queue and stopped.
+	std::condition_variable queued;      ///< Wakes the workers when a request is queued or the server stops.
+	std::condition_variable taken;       ///< Wakes the reader when a worker took a request from a full queue.
+	std::deque<Request> requests;        ///< Requests not taken by a worker yet.
+	bool stopped;                        ///< True when the reader returned.
+	std::atomic<long long> answered;     ///< Requests answered.
+};
+
+#endif
@@ -4,10 +4,11 @@
 #define _RANDOMMAZE_HPP_
 
 #include "CellStates.hpp"
+#include "Grid.hpp"
 #include <vector>
 #include <cstdlib>
 #include <stack>
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 
 /// \class RandomMaze
 /// \brief Class for generating random mazes.
@@ -15,7 +16,7 @@ class RandomMaze {
 private:
 	int rows;												///< Number of rows in the maze.
 	int cols;												///< Number of columns in the maze.
-	std::vector<std::vector<CellState>> grid;				///< Grid representing the maze.
+	Grid<CellState> grid;									///< Grid representing the maze.
 	bool finished;											///< Flag indicating if maze generation is finished.
 
 	int current_row_for_random_maze;						///< Current row during random maze generation.
@@ -50,9 +51,9 @@ public:
 	/// \brief Set up a random maze.
 	void SetUpRandomMaze();
 	
-	/// \brief Set the grid of the maze.
+	/// \brief Set the grid of the maze, the maze takes the dimensions of the grid.
 	/// \param replacement_grid The grid to replace the current maze grid with.
-	void setGrid(const std::vector<std::vector<CellState>>& replacement_grid);
+	void setGrid(const Grid<CellState>& replacement_grid);
 
 	/// \brief Check if maze generation is finished.
 	/// \return True if maze generation is finished, otherwise false.
@@ -60,7 +61,7 @@ public:
 
 	/// \brief Get the grid representing the maze.
 	/// \return The grid representing the maze.
-	std::vector<std::vector<CellState>> getGrid();
+	const Grid<CellState>& getGrid() const;
 
 
 };
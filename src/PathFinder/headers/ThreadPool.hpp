@@ -0,0 +1,61 @@
+#pragma once
+
+#ifndef _THREADPOOL_HPP_
+#define _THREADPOOL_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+#define BARRIER_SPINS 4096 // Checks of a waiting thread before it yields its core to the other threads
+
+/// \class ThreadPool
+/// \brief A fixed set of threads which run one job together, the calling thread takes part as worker 0.
+/// \details The threads are started once and sleep between the jobs. A job is given the index of the worker running it and
+/// splits the work by it. Inside a job the workers synchronize with Barrier, which spins instead of sleeping, so a job can
+/// pass many short phases without waking the threads again.
+class ThreadPool {
+public:
+	/// \brief Constructor, starts the threads.
+	/// \param threads The number of workers with the calling thread, 0 for one per hardware thread.
+	explicit ThreadPool(const int& threads = 0);
+
+	/// \brief Destructor, stops and joins the threads.
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// \brief Run a job on every worker and wait until all of them returned.
+	/// \param job The job, called with the index of the worker from 0 to the number of workers - 1.
+	void Run(const std::function<void(int)>& job);
+
+	/// \brief Wait until every worker of the running job reached the barrier, only called from inside a job.
+	void Barrier();
+
+	/// \brief Get the number of workers, the calling thread included.
+	int getThreadCount() const;
+
+private:
+	/// \brief Loop of a started thread, runs every job until the pool is destroyed.
+	void Work(const int& worker);
+
+	std::vector<std::thread> threads;            ///< The started threads, workers 1 to the number of workers - 1.
+	int thread_count;                            ///< Number of workers, the calling thread included.
+
+	std::mutex mutex;                            ///< Guards the job and the counters below.
+	std::condition_variable job_ready;           ///< Wakes the threads when a job is given or the pool stops.
+	std::condition_variable job_done;            ///< Wakes the calling thread when the last thread finished the job.
+	const std::function<void(int)>* job;         ///< The running job, nullptr between the jobs.
+	unsigned job_generation;                     ///< Number of jobs given, a thread runs a job once.
+	int running;                                 ///< Started threads which have not finished the running job.
+	bool stopping;                               ///< True when the pool is destroyed.
+
+	std::atomic<int> barrier_waiting;            ///< Workers which reached the current barrier.
+	std::atomic<unsigned> barrier_generation;    ///< Number of barriers passed, the waiting workers spin until it changes.
+};
+
+#endif
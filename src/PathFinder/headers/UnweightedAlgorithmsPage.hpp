@@ -5,6 +5,7 @@
 
 #include <SFML/Graphics.hpp>
 #include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
 #include <vector>
 
 /// \class UnweightedAlgorithmsPage
@@ -17,9 +18,16 @@ private:
     /// \brief Reset the grid to initial state.
     void ResetGrid();
     
-    std::vector<std::vector<CellState>> obstacles; ///< Grid representing obstacles in the maze.
+    Grid<CellState> obstacles; ///< Grid representing obstacles in the maze.
+    int grid_width;            ///< Number of cells in a row of the grid.
+    int grid_height;           ///< Number of rows of the grid.
 
 public:
+    /// \brief Constructor to set the dimensions of the grid shown on the page.
+    /// \param width The number of cells in a row.
+    /// \param height The number of rows.
+    UnweightedAlgorithmsPage(const int& width = 25, const int& height = 25);
+
     /// \brief Display the unweighted algorithms page.
     /// \param window The SFML render window to display the page on.
     void Display(sf::RenderWindow& window);
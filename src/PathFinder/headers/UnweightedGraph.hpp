@@ -4,21 +4,58 @@
 #define _UWEIGHTEDGRAPH_HPP_
 
 #include "../headers/CellStates.hpp"
+#include "../headers/Grid.hpp"
+#include "../headers/BitboardBFS.hpp"
+#include "../headers/BucketQueue.hpp"
+#include "../headers/Heuristics.hpp"
 #include <vector>
 #include <queue>
 #include <stack>
 #include <functional>
-#include <SFML/Graphics.hpp>
+#include <array>
+#include <SFML/System/Vector2.hpp>
 
 /// \struct PointComparator
-/// \brief Functor for comparing points in priority queues.
+/// \brief Functor for comparing cells by their cost in priority queues, the cells are stored by their index in the grid.
 template<typename T>
 struct PointComparator {
-	bool operator()(const std::pair<T, sf::Vector2i>& a, const std::pair<T, sf::Vector2i>& b) const {
+	bool operator()(const std::pair<T, uint32_t>& a, const std::pair<T, uint32_t>& b) const {
 		return a.first > b.first;
 	}
 };
 
+/// \enum Connectivity
+/// \brief The moves allowed on the grid.
+enum class Connectivity {
+	Four, ///< Only the straight moves, every move costs 1.
+	Eight ///< The straight and the diagonal moves, the costs are fixed-point, 70 for a straight move and 99 for a diagonal one.
+};
+
+/// \enum CornerCutting
+/// \brief When a diagonal move may pass next to an obstacle.
+enum class CornerCutting {
+	Allow,               ///< Every diagonal move to a free cell is allowed, even between two obstacles.
+	ForbidIfBothBlocked, ///< A diagonal move is allowed if at least one of the two straight neighbours it passes is free.
+	Forbid               ///< A diagonal move is only allowed if both straight neighbours it passes are free.
+};
+
+/// \enum GridAlgorithm
+/// \brief The algorithm set up last on an unweighted graph, stepped by RunSteps.
+enum class GridAlgorithm {
+	None,
+	BFS,
+	DFS,
+	Dijkstra,
+	AStar,
+	GBFS,
+	JPS,
+	JPSPlus,
+	BitboardBFS,
+	BidirectionalBFS,
+	BidirectionalDijkstra,
+	BidirectionalAStar
+};
+
 /// \class UnweightedGraph
 /// \brief Class for representing an unweighted graph and running various algorithms on it.
 class UnweightedGraph {
@@ -27,7 +64,7 @@ public:
 	/// \param vertices_of_the_graph The grid representing the vertices of the graph, the grid.
 	/// \param starting_point The starting point of the graph.
 	/// \param ending_point The ending point of the graph.
-	UnweightedGraph(const std::vector<std::vector<CellState>>& vertices_of_the_graph, const sf::Vector2i& starting_point, const sf::Vector2i& ending_point);
+	UnweightedGraph(const Grid<CellState>& vertices_of_the_graph, const sf::Vector2i& starting_point, const sf::Vector2i& ending_point);
 
 	/// \brief Run Breadth First Search algorithm.
 	void RunBFS();
@@ -44,6 +81,34 @@ public:
 	/// \brief Run Greedy Best-First Search algorithm.
 	void RunGBFS();
 
+	/// \brief Run Jump Point Search, A* which only expands jump points and skips the symmetric paths.
+	void RunJPS();
+
+	/// \brief Run Jump Point Search with the jump distances looked up from the precomputed table.
+	void RunJPSPlus();
+
+	/// \brief Run Breadth First Search on the bitboards, every call expands a whole wavefront.
+	void RunBitboardBFS();
+
+	/// \brief Run Breadth First Search from the start and from the end at the same time, the smaller frontier is expanded.
+	void RunBidirectionalBFS();
+
+	/// \brief Run Dijkstra's algorithm from the start and from the end at the same time, the smaller frontier is expanded.
+	void RunBidirectionalDijkstra();
+
+	/// \brief Run A* from the start and from the end at the same time, the smaller frontier is expanded.
+	void RunBidirectionalAStar();
+
+	/// \brief Run steps of the algorithm set up last until it finishes or the number of steps is reached.
+	/// \param steps The maximum number of steps.
+	/// \param animate True if the expanded cells are marked as helpers on the grid, as the single steps do.
+	/// \return The number of steps run.
+	long long RunSteps(const long long& steps, const bool& animate = false);
+
+	/// \brief Run the algorithm set up last until it finishes, without marking the expanded cells.
+	/// \return The number of steps run.
+	long long RunToCompletion();
+
 	/// \brief Set up Breadth First Search algorithm.
 	void SetUpBFS();
 
@@ -59,13 +124,31 @@ public:
 	/// \brief Set up Greedy Best-First Search algorithm.
 	void SetUpGBFS();
 
+	/// \brief Set up Jump Point Search algorithm.
+	void SetUpJPS();
+
+	/// \brief Set up JPS+ algorithm, the jump distances are precomputed if the obstacles changed since the last time.
+	void SetUpJPSPlus();
+
+	/// \brief Set up Breadth First Search on the bitboards.
+	void SetUpBitboardBFS();
+
+	/// \brief Set up bidirectional Breadth First Search.
+	void SetUpBidirectionalBFS();
+
+	/// \brief Set up bidirectional Dijkstra's algorithm.
+	void SetUpBidirectionalDijkstra();
+
+	/// \brief Set up bidirectional A* algorithm.
+	void SetUpBidirectionalAStar();
+
 	
 	/// \brief Reset the algorithm and grid after the RouteHelper enums colored the grid differently.
 	void ResetAlgorithm();
 
-	/// \brief Trace the path from the starting node to the end.
-	/// \return The path represented by a vector of vertices.
-	std::vector<std::vector<CellState>> TraceShortestPath();
+	/// \brief Trace the path from the starting node to the end by following the parents back from the end.
+	/// \return The cells of the path from the start to the end, empty if the end was not reached.
+	std::vector<sf::Vector2i> TraceShortestPath() const;
 	
 	/// \brief Check if a cell is available next to the given cell.
 	/// \param row The row of the cell.
@@ -75,11 +158,24 @@ public:
 	
 	/// \brief Get the grid representing the vertices of the graph.
 	/// \return The grid representing the vertices.
-	std::vector<std::vector<CellState>> getVertices();
+	const Grid<CellState>& getVertices() const;
 
 	/// \brief Check if an algorithm has finished.
 	/// \return True if the algorithm has finished, otherwise false.
 	bool getFinished();
+
+	/// \brief Get the distance of a cell from the start computed by the last algorithm.
+	/// \param cell The cell to query.
+	/// \return The distance, INT_MAX if the cell was not reached.
+	int getDistance(const sf::Vector2i& cell) const;
+
+	/// \brief Get the number of cells expanded by the last algorithm.
+	/// \return The number of expanded cells.
+	long long getExpansions() const;
+
+	/// \brief Get the memory used by the per cell buffers of the graph, the grids of the searches which were not run are not allocated.
+	/// \return The number of bytes.
+	size_t getMemoryUsage() const;
 	
 	/// \brief Set the starting point of the graph.
 	/// \param starting_point The starting point to set.
@@ -89,31 +185,163 @@ public:
 	/// \param ending_point The ending point to set.
 	void setEnd(const sf::Vector2i& ending_point);
 
-	/// \brief Set the obstacles on the graph.
+	/// \brief Set the moves allowed on the grid and reset the algorithm. BFS, DFS, Dijkstra, A* and GBFS follow it, Jump Point Search,
+	/// the bitboard and the bidirectional searches always use the straight moves.
+	/// \param moves The moves allowed on the grid.
+	/// \param corners When a diagonal move may pass next to an obstacle.
+	void setConnectivity(const Connectivity& moves, const CornerCutting& corners = CornerCutting::Forbid);
+
+	/// \brief Get the moves allowed on the grid.
+	Connectivity getConnectivity() const;
+
+	/// \brief Get when a diagonal move may pass next to an obstacle.
+	CornerCutting getCornerCutting() const;
+
+	/// \brief Get the cost of a straight move of the search set up last, the distances are fixed-point multiples of it.
+	int getStraightCost() const;
+
+	/// \brief Set the obstacles on the graph, the jump distances of JPS+ are kept if the same cells are blocked.
 	/// \param obstacles The obstacles to set.
-	void setObstacles(const std::vector<std::vector<CellState>>& obstacles);
+	void setObstacles(const Grid<CellState>& obstacles);
+
+	/// \brief Raise the heuristics of the searches with the straight moves to the lower bounds of landmarks (ALT).
+	/// \param landmarks Landmarks built for the current obstacles, nullptr to use only the geometric distance. They are not copied.
+	void setLandmarks(const Landmarks* landmarks);
 
 private:
+	/// \brief Run one step of Breadth First Search, Animate marks the expanded cell as a helper, Diagonal adds the diagonal moves.
+	template<bool Animate, bool Diagonal>
+	void StepBFS();
+
+	/// \brief Run one step of Depth First Search.
+	template<bool Animate, bool Diagonal>
+	void StepDFS();
+
+	/// \brief Run one step of Dijkstra's algorithm.
+	template<bool Animate, bool Diagonal>
+	void StepDijkstra();
+
+	/// \brief Run one step of A* algorithm.
+	template<bool Animate, bool Diagonal>
+	void StepAStar();
+
+	/// \brief Run one step of Greedy Best-First Search algorithm.
+	template<bool Animate, bool Diagonal>
+	void StepGBFS();
+
+	/// \brief Expand one wavefront of Breadth First Search on the bitboards.
+	template<bool Animate>
+	void StepBitboardBFS();
+
+	/// \brief Run one step of bidirectional Breadth First Search.
+	template<bool Animate>
+	void StepBidirectionalBFS();
+
+	/// \brief Run steps of the algorithm set up last, the algorithm is picked once and its step is called in a loop.
+	template<bool Animate, bool Diagonal>
+	long long RunStepsOf(const long long& steps);
+
+	/// \brief Check the corner cutting rule of a move, the straight moves are always allowed.
+	bool CanMoveDiagonally(const int& x, const int& y, const int& direction) const;
+
+	/// \brief Get the cost of a move in a direction, 1 for the 4-connected grid.
+	template<bool Diagonal>
+	static int MoveCost(const int& direction);
+
+	/// \brief Set the heuristics for the moves of the search, the targets are the end and the start.
+	void SetUpHeuristics(const Connectivity& moves);
+
+	/// \brief Check if a cell is inside the grid and is not an obstacle.
+	bool IsFree(const int& x, const int& y) const;
+
+	/// \brief Check if a cell reached by a horizontal move has a forced vertical neighbour.
+	/// \param x The x-coordinate of the cell.
+	/// \param y The y-coordinate of the cell.
+	/// \param dx The direction of the horizontal move, -1 or 1.
+	bool HasForcedNeighbour(const int& x, const int& y, const int& dx) const;
+
+	/// \brief Scan from a cell in a direction until a jump point, an obstacle or the end of the grid is reached.
+	/// \param x The x-coordinate of the cell the scan starts from.
+	/// \param y The y-coordinate of the cell the scan starts from.
+	/// \param direction The index of the direction in the helper arrays.
+	/// \return The jump point, or (-1, -1) if there is none.
+	template<bool Animate>
+	sf::Vector2i Jump(const int& x, const int& y, const int& direction);
+
+	/// \brief Same as Jump, but the distance is read from the precomputed jump distances.
+	sf::Vector2i JumpPlus(const int& x, const int& y, const int& direction);
+
+	/// \brief Precompute the distance to the next jump point or obstacle from every cell in every direction.
+	void ComputeJumpDistances();
+
+	/// \brief Run one step of Jump Point Search, the successors are found by Jump or JumpPlus.
+	template<bool Animate>
+	void StepJumpPointSearch(const bool& use_jump_distances);
+
+	/// \brief Set the parents of the cells skipped by the jumps of the path found by Jump Point Search.
+	void FinishJumpPointSearch();
+
+	/// \brief Reset the searches from both ends, the start and the end become the first cells of the two frontiers.
+	/// \param closed_on_pop True if the visited flags mark the expanded cells (Dijkstra, A*), false if they mark the reached cells (BFS).
+	void SetUpBidirectional(const bool& closed_on_pop);
+
+	/// \brief Run one step of bidirectional Dijkstra's algorithm or A*.
+	/// \param use_heuristic True for A*, the forward search is guided to the end and the backward search to the start.
+	template<bool Animate>
+	void StepBidirectionalBestFirst(const bool& use_heuristic);
+
+	/// \brief Remember the edge between the two searches if it closes a shorter path than the best one so far.
+	/// \param forward True if the cell belongs to the forward search.
+	/// \param cell The expanded cell.
+	/// \param neighbour The neighbour of the cell reached by the other search.
+	/// \param length The length of the path through the edge.
+	void UpdateMeetingPoint(const bool& forward, const sf::Vector2i& cell, const sf::Vector2i& neighbour, const int& length);
+
+	/// \brief Join the halves of the best path found by the two searches, the parents of the backward half are turned around.
+	void FinishBidirectionalSearch();
+
 	bool finished;                                 ///< Flag indicating if an algorithm has finished.
+	GridAlgorithm algorithm;                       ///< The algorithm set up last, None after a reset.
+	long long expansions;                          ///< Number of cells expanded by the current algorithm.
 
-	const int row_adder[4] = { -1, 0, 1, 0 };      ///< Helper array for row movement.
-	const int col_adder[4] = { 0, 1, 0, -1 };      ///< Helper array for column movement.
+	const int row_adder[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };   ///< Helper array for row movement, the straight moves first, then the diagonal ones.
+	const int col_adder[8] = { 0, 1, 0, -1, -1, -1, 1, 1 };   ///< Helper array for column movement.
+	Connectivity connectivity;                     ///< The moves allowed for BFS, DFS, Dijkstra, A* and GBFS.
+	CornerCutting corner_cutting;                  ///< When a diagonal move may pass next to an obstacle.
+	int straight_cost;                             ///< Cost of a straight move of the search set up last, 1 unless it uses the diagonal moves.
 
 	sf::Vector2i start;                            ///< Start point of the graph.
 	sf::Vector2i end;                              ///< End point of the graph.
+	Heuristic heuristic;                           ///< Estimate of the cost to the end, used by A*, GBFS, JPS and the forward search of bidirectional A*.
+	Heuristic backward_heuristic;                  ///< Estimate of the cost to the start, used by the backward search of bidirectional A*.
+	const Landmarks* landmarks;                    ///< Landmarks raising the heuristics, nullptr if there are none.
+
+	Grid<CellState> vertices;                      ///< Grid representing the vertices of the graph.
+	Grid<int> distances;                           ///< Grid of distances of the vertices from the start.
+	Grid<unsigned char> visited;                   ///< Grid indicating visited vertices, one byte per cell so it can be cleared with a memset.
+	Grid<unsigned char> parents;                   ///< Index of the direction of the move which reached every cell from its parent, NO_DIRECTION for the start and the unreached cells.
+
+	std::queue<uint32_t> bfs_queue;                ///< Queue for Breadth First Search.
+	std::stack<uint32_t> dfs_stack;                ///< Stack for Depth First Search.
+	BucketQueue dijkstra_priority_queue;           ///< Bucket queue for Dijkstra's algorithm, keyed by the distance.
+	BucketQueue astar_priority_queue;              ///< Bucket queue for A* algorithm, keyed by the distance plus the heuristic.
+	std::priority_queue<std::pair<int, uint32_t>, std::vector<std::pair<int, uint32_t>>, PointComparator<int>> gbfs_priority_queue;        ///< Priority queue for Greedy Best-First Search algorithm, keyed by the heuristic.
+	std::priority_queue<std::pair<int, uint32_t>, std::vector<std::pair<int, uint32_t>>, PointComparator<int>> jps_priority_queue;        ///< Priority queue for Jump Point Search.
 
-	int column_size;                               ///< Number of columns in the grid.
-	int row_size;                                  ///< Number of rows in the grid.
+	Grid<std::array<int, 4>> jump_distances;       ///< Steps to the next jump point (positive) or to the last cell before an obstacle (zero or negative) for every direction.
+	bool jump_distances_ready;                     ///< Flag indicating if the jump distances belong to the current obstacles.
 
-	std::vector<std::vector<CellState>> vertices;  ///< Grid representing the vertices of the graph.
-	std::vector<std::vector<int>> distances;       ///< Matrix of distances between vertices.
-	std::vector<std::vector<bool>> visited;        ///< Matrix indicating visited vertices.
+	BitboardBFS bitboard_bfs;                      ///< Wavefront engine for Breadth First Search on the bitboards.
 
-	std::queue<sf::Vector2i> bfs_queue;            ///< Queue for Breadth First Search.
-	std::stack<sf::Vector2i> dfs_stack;            ///< Stack for Depth First Search.
-	std::priority_queue<std::pair<int, sf::Vector2i>, std::vector<std::pair<int, sf::Vector2i>>, PointComparator<int>> dijkstra_priority_queue;  ///< Priority queue for Dijkstra's algorithm.
-	std::priority_queue<std::pair<float, sf::Vector2i>, std::vector<std::pair<float, sf::Vector2i>>, PointComparator<float>> astar_priority_queue;  ///< Priority queue for A* algorithm.
-	std::priority_queue<std::pair<float, sf::Vector2i>, std::vector<std::pair<float, sf::Vector2i>>, PointComparator<float>> gbfs_priority_queue;    ///< Priority queue for Greedy Best-First Search algorithm.
+	std::queue<uint32_t> backward_bfs_queue;       ///< Queue of the backward search of bidirectional Breadth First Search, bfs_queue is the forward one.
+	BucketQueue forward_priority_queue;            ///< Forward bucket queue of bidirectional Dijkstra and A*.
+	BucketQueue backward_priority_queue;           ///< Backward bucket queue of bidirectional Dijkstra and A*.
+	Grid<int> backward_distances;                  ///< Grid of distances of the vertices from the end, filled by the backward search, allocated by the first bidirectional search.
+	Grid<unsigned char> backward_visited;          ///< Grid indicating the vertices visited by the backward search.
+	Grid<unsigned char> backward_parents;          ///< Directions of the moves of the backward search, followed backwards they lead to the end.
+	int best_meeting_length;                       ///< Length of the shortest path through an edge between the two searches, INT_MAX if there is none yet.
+	sf::Vector2i meeting_forward;                  ///< Cell of the forward search on the best edge between the two searches.
+	sf::Vector2i meeting_backward;                 ///< Cell of the backward search on the best edge between the two searches.
 };
 
 #endif
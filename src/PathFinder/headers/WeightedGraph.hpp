@@ -4,66 +4,159 @@
 #define _WEIGHTEDGRAPH_HPP_
 
 #include <vector>
-#include <unordered_map>
 #include <queue>
+#include <deque>
 #include <stack>
-#include <SFML/Graphics.hpp>
+#include "../headers/Landmarks.hpp"
 
-/// \struct PointComparator
-/// \brief Functor for comparing points in priority queues.
-struct PointComparator {
+class ThreadPool;
+
+/// \struct VertexComparator
+/// \brief Functor for comparing vertices by their distance in priority queues.
+struct VertexComparator {
     bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) {
-        return a.second > b.second;
+        return a.first > b.first;
     }
 };
 
+/// \struct GraphEdge
+/// \brief An edge of a weighted graph which is still being edited.
+struct GraphEdge {
+    int from;    ///< The vertex the edge starts from.
+    int to;      ///< The vertex the edge goes to.
+    int weight;  ///< The weight of the edge.
+};
+
+/// \enum GraphEventType
+/// \brief What happened to a vertex during an animated step.
+enum class GraphEventType {
+    Visit,          ///< The vertex was taken from the queue or the stack of the algorithm.
+    Relax,          ///< An edge lowered the distance of the vertex.
+    NegativeCycle   ///< Bellman-Ford found an edge into the vertex which is on or behind a negative cycle.
+};
+
+/// \struct GraphEvent
+/// \brief An event of an animated step, consumed by the view which draws the graph.
+struct GraphEvent {
+    GraphEventType type;  ///< What happened.
+    int vertex;           ///< The vertex it happened to.
+    int parent;           ///< The vertex the edge of a relaxation comes from, -1 for the other events.
+    int distance;         ///< The distance of the vertex after the event.
+};
+
+/// \enum GraphAlgorithm
+/// \brief The algorithm set up last on a weighted graph, stepped by RunSteps.
+enum class GraphAlgorithm {
+    None,
+    Dijkstra,
+    BFS,
+    DFS,
+    BellmanFord,
+    AStar,
+    SPFA
+};
+
 /// \class WeightedGraph
 /// \brief Class for representing a weighted graph and running various algorithms on it.
+/// \details The graph only keeps the data of the algorithms, the animated steps record what they did as GraphEvents which
+/// WeightedGraphView turns into colors, the steps run headless record nothing. The edges are collected in a list while the graph is edited. Freeze packs them into compressed sparse rows, the
+/// edges leaving a vertex are stored next to each other in the order they were added, so the searches read them sequentially.
+/// Adding an edge to a frozen graph moves the edges back to the list.
 class WeightedGraph {
 private:
-    std::unordered_map<int, std::vector<std::pair<int, int>>> adjacency_list;  ///< Adjacency list representing the graph.
+    std::vector<GraphEdge> edge_builder;               ///< Edges added since the graph was last frozen.
+    std::vector<int> csr_offsets;                      ///< First edge leaving every vertex, vertex count + 1 entries, empty if the graph is not frozen.
+    std::vector<int> csr_targets;                      ///< Vertex every edge goes to, grouped by the vertex it leaves.
+    std::vector<int> csr_weights;                      ///< Weight of every edge, in the order of csr_targets.
+    bool frozen;                                       ///< True if the edges are stored in the compressed rows.
 
-    std::vector<sf::CircleShape> vertices;             ///< Vector of vertices in the graph.
-    std::vector<sf::Text> vertex_numbers;              ///< Vector of texts representing vertex numbers.
-    std::vector<sf::VertexArray> edges;                ///< Vector of edge graphics.
-    std::vector<sf::Text> edge_weights;                ///< Vector of texts representing edge weights.
-    std::vector<sf::ConvexShape> edge_going_to_signaling_triangles;  ///< Vector of triangles indicating edge directions.
+    int vertex_count;                                  ///< Number of vertices in the graph.
+    std::vector<GraphEvent> events;                    ///< Events of the animated steps since the view consumed them.
 
     std::vector<bool> visited;                         ///< Vector indicating visited nodes.
     std::vector<int> distances;                        ///< Vector to save distances of nodes from each other.
     std::vector<int> parents;                          ///< Vector to save parents of each node.
 
     bool finished;                                     ///< Flag indicating if an algorithm has finished.
+    GraphAlgorithm algorithm;                          ///< The algorithm set up last, None after a reset.
+    int source;                                        ///< Vertex the algorithms start from.
+    int destination;                                   ///< Vertex the path is traced to, -1 means the last vertex.
+    long long expansions;                              ///< Number of vertices expanded (edges scanned for Bellman-Ford) by the current algorithm.
+    const Landmarks* landmarks;                        ///< Landmarks giving the lower bounds of A*, nullptr if A* runs without a heuristic.
 
     int bellman_curr_vertex;                           ///< Current vertex during Bellman-Ford algorithm execution.
-    int bellman_curr_edge;                             ///< Current edge during Bellman-Ford algorithm execution.
+    int bellman_curr_edge;                             ///< Current edge of the compressed rows during Bellman-Ford algorithm execution.
+    int bellman_curr_round;                            ///< Current pass over all edges during Bellman-Ford algorithm execution.
+    bool bellman_relaxed;                              ///< True if the current pass of Bellman-Ford lowered a distance.
+    std::deque<int> spfa_queue;                        ///< Vertices whose distance dropped since SPFA last scanned them.
+    std::vector<bool> spfa_queued;                     ///< Vector indicating the vertices in the SPFA queue.
+    long long spfa_queue_sum;                          ///< Sum of the distances of the queued vertices, for the Large Label Last rule.
+    std::vector<int> tree_next;                        ///< Next vertex of the shortest path tree of SPFA in preorder, -1 after the last one.
+    std::vector<int> tree_previous;                    ///< Previous vertex of the tree in preorder, -1 before the source.
+    std::vector<int> tree_depth;                       ///< Depth of every vertex in the tree, -1 for the vertices outside of it.
+    std::vector<int> negative_cycle;                   ///< Vertices of the negative cycle found by the last algorithm, in the order of its edges.
     std::queue<int> bfs_queue;                         ///< Queue for Breadth First Search.
     std::stack<int> dfs_stack;                         ///< Stack for Depth First Search.
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, PointComparator> dijkstra_priority_queue;  ///< Priority queue for Dijkstra's algorithm.
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, VertexComparator> dijkstra_priority_queue;  ///< Priority queue for Dijkstra's algorithm.
+
+    /// \brief Run one step of Dijkstra's algorithm, Animate records the events of the step.
+    template<bool Animate>
+    void StepDijkstra();
+
+    /// \brief Run one step of Breadth First Search algorithm.
+    template<bool Animate>
+    void StepBFS();
+
+    /// \brief Run one step of Depth First Search algorithm.
+    template<bool Animate>
+    void StepDFS();
+
+    /// \brief Relax one edge of Bellman-Ford algorithm.
+    template<bool Animate>
+    void StepBellmanFord();
+
+    /// \brief Run one step of A*, it stops when the destination is expanded.
+    template<bool Animate>
+    void StepAStar();
 
+    /// \brief Scan the edges of the next vertex of the SPFA queue.
+    template<bool Animate>
+    void StepSPFA();
+
+    /// \brief Add a vertex to the SPFA queue, in front if its distance is below the one of the first vertex (Small Label First).
+    void PushSPFA(const int& vertex);
+
+    /// \brief Move a vertex which SPFA relaxed under the vertex its edge comes from, its subtree is removed from the tree.
+    /// \return False if the vertex the edge comes from was in the removed subtree, the edge closes a negative cycle then.
+    bool MoveInTree(const int& vertex, const int& parent);
+
+    /// \brief Store the negative cycle the parents lead into from a vertex, the parents must contain a cycle.
+    template<bool Animate>
+    void ExtractNegativeCycle(int vertex);
+
+    /// \brief Get the lower bound of the distance from a vertex to the destination, 0 without landmarks.
+    int Estimate(const int& vertex) const;
+
+    /// \brief Run steps of the algorithm set up last, the algorithm is picked once and its step is called in a loop.
+    template<bool Animate>
+    long long RunStepsOf(const long long& steps);
+
+    /// \brief Move the edges of the compressed rows back to the edge list, so more edges can be added.
+    void Thaw();
 
 
 public:
     /// \brief Default constructor to initialize WeightedGraph object.
     WeightedGraph();
 
-    /// \brief Add an edge to the graph.
-    void AddEdge(const int& from, const int& to, const int& weight, const sf::VertexArray& edge, const sf::Text& weight_graphics);
-    
-    /// \brief Clear the vectors containing graph elements.
+    /// \brief Remove the vertices and the edges of the graph.
     void Clear();
 
-    /// \brief Add a vertex to the graph.
-    void AddVertex(const sf::CircleShape& vertex, const sf::Text& vertex_number);
-
-    /// \brief Add a signaling triangle to indicate direction of an edge.
-    void AddTriangle(const sf::ConvexShape& triangle);
-
-    /// \brief Change color of a vertex.
-    void ChangeVertexColor(const sf::Color& color, const int& index);
+    /// \brief Add an edge to the graph.
+    void AddEdge(const int& from, const int& to, const int& weight);
 
-    /// \brief Draw the graph on a given render window.
-    void Draw(sf::RenderWindow& window);
+    /// \brief Add a vertex to the graph, its number is the number of vertices before it.
+    void AddVertex();
 
     /// \brief Run Dijkstra's algorithm.
     void RunDijkstra();
@@ -77,36 +170,156 @@ public:
     /// \brief Run Bellman-Ford algorithm.
     void RunBellmanFord();
 
+    /// \brief Run one step of A* algorithm.
+    void RunAStar();
+
+    /// \brief Run one step of SPFA.
+    void RunSPFA();
+
+    /// \brief Run steps of the algorithm set up last until it finishes or the number of steps is reached.
+    /// \param steps The maximum number of steps.
+    /// \param animate True if the steps record their events, as the single steps do.
+    /// \return The number of steps run.
+    long long RunSteps(const long long& steps, const bool& animate = false);
+
+    /// \brief Run the algorithm set up last until it finishes, without recording events.
+    /// \return The number of steps run.
+    long long RunToCompletion();
+
     /// \brief Set up Dijkstra's algorithm.
     void SetUpDijkstra();
 
+    /// \brief Find the distances from the source to every vertex with delta-stepping, on all threads of a pool.
+    /// \details The vertices are kept in buckets of width delta by their distance. The buckets are emptied in order, the threads
+    /// relax the light edges (not heavier than delta) of the vertices of the current bucket until it stays empty, then the heavy
+    /// edges of the vertices it held. The distances are the ones of Dijkstra's algorithm. Every parent is on a shortest path too,
+    /// when a vertex has several, the one whose relaxation came first is kept, so it may differ from the one of Dijkstra's algorithm.
+    /// \param pool The threads to run on.
+    /// \param delta The width of the buckets, 0 for the one of SuggestDelta.
+    /// \return True if the distances were found, false if an edge has a negative weight.
+    bool RunDeltaStepping(ThreadPool& pool, const int& delta = 0);
+
+    /// \brief Get the bucket width of delta-stepping for this graph, the largest weight over the average degree.
+    int SuggestDelta() const;
+
     /// \brief Set up Breadth First Search algorithm.
     void SetUpBFS();
 
     /// \brief Set up Depth First Search algorithm.
     void SetUpDFS();
 
-    /// \brief Set up Bellman-Ford algorithm.
+    /// \brief Set up Bellman-Ford algorithm, it stops after the first pass which lowers no distance.
     void SetUpBellmanFord();
 
-    /// \brief Trace the shortest path found by the algorithm.
-    void TracePath();
+    /// \brief Set up SPFA, the queue-based Bellman-Ford algorithm.
+    /// \details Only the vertices whose distance dropped are scanned again. A vertex with a smaller distance than the first one
+    /// is queued in front (Small Label First) and a first vertex above the average distance of the queue is moved to the back
+    /// (Large Label Last). The relaxed vertices form a shortest path tree, relaxing a vertex removes its subtree from the tree and
+    /// its removed descendants are not scanned until they are reached again. An edge from a vertex of that subtree closes a
+    /// negative cycle, so a cycle is found as soon as its last edge is relaxed instead of after |V| - 1 passes.
+    void SetUpSPFA();
+
+    /// \brief Get the negative cycle found by Bellman-Ford or SPFA.
+    /// \return The vertices of the cycle in the order of its edges, the last one has an edge to the first one. Empty if none was found.
+    const std::vector<int>& getNegativeCycle() const;
+
+    /// \brief Set up A* algorithm to the destination, guided by the landmarks if they are set.
+    void SetUpAStar();
+
+    /// \brief Use the lower bounds of landmarks in A*, the weights must not be negative.
+    /// \param landmarks The landmarks built for this graph, nullptr to run A* without a heuristic.
+    void setLandmarks(const Landmarks* landmarks);
+
+    /// \brief Trace the path found by the algorithm back from the destination.
+    /// \return The vertices of the path from the source to the destination, empty if the destination was not reached.
+    std::vector<int> TracePath() const;
 
-    /// \brief Reset the graph and algorithm states.
+    /// \brief Reset the algorithm states, the events are dropped.
     void Reset();
 
-    /// \brief Get the vertices of the graph.
-    /// \return Vector of vertices.
-    std::vector<sf::CircleShape> getVertices();
+    /// \brief Get the events recorded by the animated steps since they were last cleared.
+    const std::vector<GraphEvent>& getEvents() const;
+
+    /// \brief Drop the recorded events, called by the view once it drew them.
+    void ClearEvents();
+
+    /// \brief Pack the edges into compressed sparse rows, the algorithms freeze the graph when they are set up.
+    /// \details Edges whose vertices are not in the graph are dropped.
+    void Freeze();
+
+    /// \brief Replace the vertices and the edges by compressed sparse rows built outside of the graph, the graph is frozen.
+    /// \details The loaders of large files pack the edges themselves, so no edge list is kept in between.
+    /// \param vertices The number of vertices.
+    /// \param offsets The first edge leaving every vertex, vertices + 1 entries, the last one is the number of edges.
+    /// \param targets The vertex every edge goes to, grouped by the vertex it leaves.
+    /// \param weights The weight of every edge, in the order of the targets.
+    void LoadCompressedRows(const int& vertices, std::vector<int>&& offsets, std::vector<int>&& targets, std::vector<int>&& weights);
+
+    /// \brief Check if the edges are stored in the compressed rows.
+    bool isFrozen() const;
+
+    /// \brief Call a function with the start, the end and the weight of every edge, frozen or not.
+    template<typename Function>
+    void ForEachEdge(Function function) const {
+        if (!frozen) {
+            for (const GraphEdge& edge : edge_builder) {
+                function(edge.from, edge.to, edge.weight);
+            }
+            return;
+        }
+        for (int vertex = 0; vertex + 1 < static_cast<int>(csr_offsets.size()); vertex++) {
+            for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+                function(vertex, csr_targets[i], csr_weights[i]);
+            }
+        }
+    }
+
+    /// \brief Get the weight of the lightest edge between two vertices of a frozen graph.
+    /// \return The weight, INT_MAX if there is no such edge.
+    int getEdgeWeight(const int& from, const int& to) const;
+
+    /// \brief Get the offsets of the compressed rows, the edges leaving vertex v are the ones from offsets[v] to offsets[v + 1].
+    const std::vector<int>& getEdgeOffsets() const;
+
+    /// \brief Get the vertex every edge of the compressed rows goes to.
+    const std::vector<int>& getEdgeTargets() const;
+
+    /// \brief Get the weight of every edge of the compressed rows.
+    const std::vector<int>& getEdgeWeights() const;
 
-    /// \brief Get the adjacency list of a vertex.
-    /// \param vertex The vertex whose adjacency list is to be retrieved.
-    /// \return The adjacency list of the vertex.
-    std::vector<std::pair<int, int>> getAdjacencyList(const int& vertex);
+    /// \brief Get the number of edges in the graph.
+    int getEdgeCount() const;
+
+    /// \brief Get the bytes of the edges and of the buffers of the algorithms, without the graphics.
+    size_t getMemoryUsage() const;
 
     /// \brief Check if an algorithm has finished.
     /// \return True if the algorithm has finished, otherwise false.
     bool getFinished();
+
+    /// \brief Set the vertex the algorithms start from.
+    void setSource(const int& vertex);
+
+    /// \brief Get the vertex the algorithms start from.
+    int getSource() const;
+
+    /// \brief Set the vertex the path is traced to, -1 means the last vertex.
+    void setDestination(const int& vertex);
+
+    /// \brief Get the vertex the path is traced to.
+    int getDestination() const;
+
+    /// \brief Get the number of vertices in the graph.
+    int getVertexCount() const;
+
+    /// \brief Get the distances computed by the last algorithm.
+    const std::vector<int>& getDistances() const;
+
+    /// \brief Get the parents computed by the last algorithm.
+    const std::vector<int>& getParents() const;
+
+    /// \brief Get the number of vertices expanded by the last algorithm, for Bellman-Ford the number of edges scanned.
+    long long getExpansions() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef _WEIGHTEDGRAPHVIEW_HPP_
+#define _WEIGHTEDGRAPHVIEW_HPP_
+
+#include "../headers/WeightedGraph.hpp"
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/// \class WeightedGraphView
+/// \brief The SFML graphics of a weighted graph, colored by the events of the animated steps of WeightedGraph.
+/// \details The vertices and the edges are added to the view and to the graph together, vertex i of the view is vertex i of the
+/// graph. The graph runs without knowing about the view, which only pays for the events it draws.
+class WeightedGraphView {
+public:
+	/// \brief Add the graphics of a vertex.
+	/// \param vertex The circle of the vertex.
+	/// \param vertex_number The text with the number of the vertex.
+	void AddVertex(const sf::CircleShape& vertex, const sf::Text& vertex_number);
+
+	/// \brief Add the graphics of an edge.
+	/// \param edge The line of the edge.
+	/// \param weight_graphics The text with the weight of the edge.
+	void AddEdge(const sf::VertexArray& edge, const sf::Text& weight_graphics);
+
+	/// \brief Add a signaling triangle to indicate direction of an edge.
+	void AddTriangle(const sf::ConvexShape& triangle);
+
+	/// \brief Remove every graphic.
+	void Clear();
+
+	/// \brief Change color of a vertex.
+	void ChangeVertexColor(const sf::Color& color, const int& index);
+
+	/// \brief Color every vertex white, as before an algorithm runs.
+	void ResetColors();
+
+	/// \brief Color the vertices by the events the graph recorded since the last call and drop the events.
+	/// \details A visited or relaxed vertex gets magenta, a vertex behind a negative cycle red.
+	void Consume(WeightedGraph& graph);
+
+	/// \brief Color the path found by the last algorithm, yellow with a green source and a red destination, a negative cycle is printed instead.
+	void ShowPath(const WeightedGraph& graph);
+
+	/// \brief Draw the graph on a given render window.
+	void Draw(sf::RenderWindow& window);
+
+	/// \brief Get the circles of the vertices.
+	const std::vector<sf::CircleShape>& getVertices() const;
+
+private:
+	std::vector<sf::CircleShape> vertices;                           ///< Vector of vertices in the graph.
+	std::vector<sf::Text> vertex_numbers;                            ///< Vector of texts representing vertex numbers.
+	std::vector<sf::VertexArray> edges;                              ///< Vector of edge graphics.
+	std::vector<sf::Text> edge_weights;                              ///< Vector of texts representing edge weights.
+	std::vector<sf::ConvexShape> edge_going_to_signaling_triangles;  ///< Vector of triangles indicating edge directions.
+};
+
+#endif
@@ -0,0 +1,959 @@
+#include "../headers/UnweightedGraph.hpp"
+#include "../headers/WeightedGraph.hpp"
+#include "../headers/RandomMaze.hpp"
+#include "../headers/HierarchicalGraph.hpp"
+#include "../headers/Landmarks.hpp"
+#include "../headers/ContractionHierarchy.hpp"
+#include "../headers/ThreadPool.hpp"
+#include "../headers/DistanceMatrix.hpp"
+#include "../headers/MapLoader.hpp"
+#include "../headers/IncrementalPlanner.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <climits>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define BENCH_LANDMARKS 8 // Landmarks of astar-alt, every one keeps a table of 4 bytes per cell
+#define MAX_LANDMARK_CELLS (2048 * 2048) // Larger grids skip astar-alt, the tables would not fit in memory next to the larger maps
+#define REPLAN_EDITS 32 // Cells of the path blocked one by one and freed again by a replanning benchmark
+#define MAX_REPLAN_CELLS (1024 * 1024) // Larger grids skip the replanning benchmarks, every edit of replan/astar copies the grid
+#define SCENARIO_TOLERANCE 1e-4 // Relative difference from the optimal length of a scenario which is a mismatch, a diagonal move costs 99/70 and not sqrt(2)
+
+// Microbenchmarks of the grid searches, the weighted graph algorithms and the maze generators.
+// Every benchmark is written as one JSON object per line, so a stored result can be used as a baseline.
+
+struct BenchOptions {
+    std::vector<sf::Vector2i> sizes = { { 64, 64 }, { 256, 256 }, { 1024, 1024 }, { 4096, 4096 }, { 8192, 8192 } };
+    std::vector<double> densities = { 0.0, 0.1, 0.3 };
+    std::vector<int> graph_sizes = { 1024, 16384, 262144 };
+    int max_bellman_ford_vertices = 4096;
+    int threads = 0;
+    int max_all_pairs_vertices = 1024;
+    std::string filter;
+    std::string output_path;
+    std::string baseline_path;
+    double threshold = 0.10;
+    double min_time = 0.2;
+    int max_repetitions = 20;
+    std::vector<std::string> scenario_paths;
+    std::string map_directory;
+    std::string csv_path;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string family;
+    std::string algorithm;
+    std::string map;
+    int width = 0;
+    int height = 0;
+    double density = 0.0;
+    int repetitions = 0;
+    double time_ns = 0.0;
+    long long expansions = 0;
+    long long peak_memory_kb = 0;
+    double bytes_per_cell = 0.0;
+    int queries = 1;
+    long long mismatches = 0;
+};
+
+// Peak resident memory of the process. On Linux the peak is reset before every benchmark,
+// so the value belongs to the benchmark alone, elsewhere it is the peak of the whole run.
+static void ResetPeakMemory() {
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+    }
+#endif
+}
+
+static long long PeakMemoryKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stoll(line.substr(6));
+        }
+    }
+#endif
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+static std::vector<std::string> Split(const std::string& text, const char& separator) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, separator)) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+// A grid size is either one side length or "WIDTHxHEIGHT"
+static sf::Vector2i ParseSize(const std::string& text) {
+    size_t separator = text.find('x');
+    if (separator == std::string::npos) {
+        int side = std::stoi(text);
+        return { side, side };
+    }
+    return { std::stoi(text.substr(0, separator)), std::stoi(text.substr(separator + 1)) };
+}
+
+static std::string SizeName(const sf::Vector2i& size) {
+    if (size.x == size.y) {
+        return std::to_string(size.x);
+    }
+    return std::to_string(size.x) + "x" + std::to_string(size.y);
+}
+
+static void PrintUsage() {
+    std::cerr << "Usage: pathfinder-bench [options]\n"
+        << "  --sizes LIST         Grid side lengths or WIDTHxHEIGHT sizes, default 64,256,1024,4096,8192\n"
+        << "  --densities LIST     Obstacle densities of the random grids, default 0,0.1,0.3\n"
+        << "  --graph-sizes LIST   Vertex counts of the weighted graphs, default 1024,16384,262144\n"
+        << "  --max-bellman-ford N Largest graph Bellman-Ford is run on, default 4096\n"
+        << "  --threads N          Threads of delta-stepping and johnson, default one per hardware thread\n"
+        << "  --max-all-pairs N    Largest graph the all-pairs algorithms are run on, default 1024\n"
+        << "  --filter TEXT        Only run the benchmarks whose name contains TEXT\n"
+        << "  --min-time SECONDS   Repeat every benchmark at least this long, default 0.2\n"
+        << "  --scenarios LIST     Only replay the queries of these MovingAI scenario files (.scen) with every grid search\n"
+        << "  --map-dir DIR        Directory of the maps of the scenarios, default the directory of every scenario file\n"
+        << "  --output FILE        Write the JSON results to FILE instead of the standard output\n"
+        << "  --csv FILE           Write the results to FILE as CSV too\n"
+        << "  --baseline FILE      Compare the results with a stored run, exits with 1 on a regression\n"
+        << "  --threshold RATIO    Allowed slowdown against the baseline, default 0.10\n";
+}
+
+static bool ParseOptions(int argc, char* argv[], BenchOptions& options) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+            if (argument == "--sizes") {
+                options.sizes.clear();
+                for (const auto& part : Split(value, ',')) options.sizes.push_back(ParseSize(part));
+            }
+            else if (argument == "--densities") {
+                options.densities.clear();
+                for (const auto& part : Split(value, ',')) options.densities.push_back(std::stod(part));
+            }
+            else if (argument == "--graph-sizes") {
+                options.graph_sizes.clear();
+                for (const auto& part : Split(value, ',')) options.graph_sizes.push_back(std::stoi(part));
+            }
+            else if (argument == "--max-bellman-ford") options.max_bellman_ford_vertices = std::stoi(value);
+            else if (argument == "--threads") options.threads = std::stoi(value);
+            else if (argument == "--max-all-pairs") options.max_all_pairs_vertices = std::stoi(value);
+            else if (argument == "--filter") options.filter = value;
+            else if (argument == "--min-time") options.min_time = std::stod(value);
+            else if (argument == "--output") options.output_path = value;
+            else if (argument == "--scenarios") options.scenario_paths = Split(value, ',');
+            else if (argument == "--map-dir") options.map_directory = value;
+            else if (argument == "--csv") options.csv_path = value;
+            else if (argument == "--baseline") options.baseline_path = value;
+            else if (argument == "--threshold") options.threshold = std::stod(value);
+            else {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return false;
+            }
+        }
+    }
+    catch (const std::exception&) {
+        std::cerr << "Invalid option value" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Runs the body until the minimal time elapsed, the best repetition is kept
+static void Measure(const BenchOptions& options, BenchResult& result, const std::function<long long()>& body) {
+    ResetPeakMemory();
+    double total = 0.0;
+    result.time_ns = 0.0;
+    result.repetitions = 0;
+    while (result.repetitions < options.max_repetitions && (result.repetitions == 0 || total < options.min_time * 1e9)) {
+        auto begin = std::chrono::steady_clock::now();
+        result.expansions = body();
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        total += elapsed;
+        if (result.repetitions == 0 || elapsed < result.time_ns) {
+            result.time_ns = elapsed;
+        }
+        result.repetitions++;
+    }
+    result.peak_memory_kb = PeakMemoryKB();
+}
+
+static Grid<CellState> MakeRandomGrid(const sf::Vector2i& size, const double& density) {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    Grid<CellState> grid(size.x, size.y, Empty);
+    for (size_t i = 0; i < grid.getSize(); i++) {
+        if (distribution(generator) < density) {
+            grid[i] = Obstacle;
+        }
+    }
+    grid(0, 0) = Empty;
+    grid(size.x - 1, size.y - 1) = Empty;
+    return grid;
+}
+
+static long long GenerateMaze(RandomMaze& maze, const std::string& type, const sf::Vector2i& size) {
+    long long steps = 0;
+    if (type == "backtracker") {
+        maze.SetUpRecursiveBacktrackerMaze({ 0, 0 }, { size.x - 1, size.y - 1 });
+        while (!maze.getFinished()) {
+            maze.GenerateRecursiveBacktrackerMaze();
+            steps++;
+        }
+    }
+    else {
+        maze.SetUpRandomMaze();
+        while (!maze.getFinished()) {
+            maze.GenerateRandomMaze();
+            steps++;
+        }
+    }
+    return steps;
+}
+
+static long long RunGridSearch(UnweightedGraph& graph, const std::string& algorithm) {
+    if (algorithm == "bfs") {
+        graph.SetUpBFS();
+    }
+    else if (algorithm == "dfs") {
+        graph.SetUpDFS();
+    }
+    else if (algorithm == "dijkstra") {
+        graph.SetUpDijkstra();
+    }
+    else if (algorithm == "astar") {
+        graph.SetUpAStar();
+    }
+    else if (algorithm == "gbfs") {
+        graph.SetUpGBFS();
+    }
+    else if (algorithm == "jps") {
+        graph.SetUpJPS();
+    }
+    else if (algorithm == "jps-plus") {
+        // The jump distance table is kept by the graph, so only the first repetition pays for the preprocessing
+        graph.SetUpJPSPlus();
+    }
+    else if (algorithm == "bitboard-bfs") {
+        graph.SetUpBitboardBFS();
+    }
+    else if (algorithm == "bidirectional-bfs") {
+        graph.SetUpBidirectionalBFS();
+    }
+    else if (algorithm == "bidirectional-dijkstra") {
+        graph.SetUpBidirectionalDijkstra();
+    }
+    else if (algorithm == "bidirectional-astar") {
+        graph.SetUpBidirectionalAStar();
+    }
+    graph.RunToCompletion();
+    return graph.getExpansions();
+}
+
+static long long RunGraphAlgorithm(WeightedGraph& graph, const std::string& algorithm) {
+    if (algorithm == "dijkstra") {
+        graph.SetUpDijkstra();
+    }
+    else if (algorithm == "astar" || algorithm == "astar-alt") {
+        graph.SetUpAStar();
+    }
+    else if (algorithm == "bellman-ford") {
+        graph.SetUpBellmanFord();
+    }
+    else if (algorithm == "spfa") {
+        graph.SetUpSPFA();
+    }
+    graph.RunToCompletion();
+    return graph.getExpansions();
+}
+
+// Random directed graph with an average out degree of 4 and weights from 1 to 100
+static void MakeRandomGraph(WeightedGraph& graph, const int& vertex_count) {
+    std::mt19937 generator(54321);
+    std::uniform_int_distribution<int> vertex_distribution(0, vertex_count - 1);
+    std::uniform_int_distribution<int> weight_distribution(1, 100);
+    for (int i = 0; i < vertex_count; i++) {
+        graph.AddVertex();
+    }
+    for (int i = 0; i < vertex_count; i++) {
+        for (int j = 0; j < 4; j++) {
+            graph.AddEdge(i, vertex_distribution(generator), weight_distribution(generator));
+        }
+    }
+}
+
+// Road-like graph: a square grid of two-way streets with weights from 1 to 100, the vertex count is rounded down to a square
+static void MakeRoadGraph(WeightedGraph& graph, const int& vertex_count) {
+    std::mt19937 generator(54321);
+    std::uniform_int_distribution<int> weight_distribution(1, 100);
+    int side = static_cast<int>(std::sqrt(static_cast<double>(vertex_count)));
+    for (int i = 0; i < side * side; i++) {
+        graph.AddVertex();
+    }
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            int vertex = y * side + x;
+            if (x + 1 < side) {
+                int weight = weight_distribution(generator);
+                graph.AddEdge(vertex, vertex + 1, weight);
+                graph.AddEdge(vertex + 1, vertex, weight);
+            }
+            if (y + 1 < side) {
+                int weight = weight_distribution(generator);
+                graph.AddEdge(vertex, vertex + side, weight);
+                graph.AddEdge(vertex + side, vertex, weight);
+            }
+        }
+    }
+}
+
+static bool Selected(const BenchOptions& options, const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+static std::string FormatDensity(const double& density) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", density);
+    return buffer;
+}
+
+static void Report(const BenchResult& result, std::vector<BenchResult>& results) {
+    std::cerr << result.name << ": " << result.time_ns / 1e6 << " ms, " << result.expansions << " expansions" << std::endl;
+    results.push_back(result);
+}
+
+static void RunGridBenchmarks(const BenchOptions& options, std::vector<BenchResult>& results) {
+    const std::vector<std::string> algorithms = { "bfs", "dfs", "dijkstra", "astar", "gbfs", "jps", "jps-plus", "bitboard-bfs",
+        "bidirectional-bfs", "bidirectional-dijkstra", "bidirectional-astar", "hpa", "astar-alt" };
+    for (const sf::Vector2i& size : options.sizes) {
+        // The maps every search runs on: random obstacles of every density and a recursive backtracker maze
+        std::vector<std::pair<std::string, double>> maps;
+        for (double density : options.densities) {
+            maps.push_back({ "random", density });
+        }
+        maps.push_back({ "backtracker", 0.0 });
+
+        for (const auto& map : maps) {
+            std::string map_name = map.first == "random" ? "random-" + FormatDensity(map.second) : map.first;
+            bool any_selected = false;
+            for (const auto& algorithm : algorithms) {
+                any_selected |= Selected(options, "grid/" + algorithm + "/" + map_name + "/" + SizeName(size));
+            }
+            if (!any_selected) {
+                continue;
+            }
+
+            Grid<CellState> grid;
+            if (map.first == "random") {
+                grid = MakeRandomGrid(size, map.second);
+            }
+            else {
+                RandomMaze maze(size.y, size.x);
+                GenerateMaze(maze, map.first, size);
+                grid = maze.getGrid();
+                grid(size.x - 1, size.y - 1) = Empty;
+            }
+
+            UnweightedGraph graph(grid, { 0, 0 }, { size.x - 1, size.y - 1 });
+            for (const auto& algorithm : algorithms) {
+                BenchResult result;
+                result.name = "grid/" + algorithm + "/" + map_name + "/" + SizeName(size);
+                if (!Selected(options, result.name)) {
+                    continue;
+                }
+                result.family = "grid";
+                result.algorithm = algorithm;
+                result.map = map.first;
+                result.width = size.x;
+                result.height = size.y;
+                result.density = map.second;
+                if (algorithm == "hpa") {
+                    // The abstraction is built once per map and is not timed, only the queries are
+                    HierarchicalGraph hierarchy(grid);
+                    Measure(options, result, [&]() {
+                        hierarchy.FindPath({ 0, 0 }, { size.x - 1, size.y - 1 });
+                        return hierarchy.getExpansions();
+                    });
+                    result.bytes_per_cell = static_cast<double>(hierarchy.getMemoryUsage()) / grid.getSize();
+                    Report(result, results);
+                    continue;
+                }
+                if (algorithm == "astar-alt") {
+                    // A* with landmark lower bounds, the tables are built once per map and are not timed
+                    if (grid.getSize() > MAX_LANDMARK_CELLS) {
+                        continue;
+                    }
+                    Landmarks landmarks;
+                    landmarks.Build(grid, BENCH_LANDMARKS);
+                    graph.setLandmarks(&landmarks);
+                    Measure(options, result, [&]() { return RunGridSearch(graph, "astar"); });
+                    result.bytes_per_cell = static_cast<double>(graph.getMemoryUsage() + landmarks.getMemoryUsage()) / grid.getSize();
+                    graph.setLandmarks(nullptr);
+                    Report(result, results);
+                    continue;
+                }
+                Measure(options, result, [&]() { return RunGridSearch(graph, algorithm); });
+                result.bytes_per_cell = static_cast<double>(graph.getMemoryUsage()) / grid.getSize();
+                Report(result, results);
+            }
+        }
+    }
+}
+
+// Blocks cells of the first path one by one and frees them again in reverse order, the path is found again after every edit.
+// D* Lite repairs its distances, A* searches the whole grid again after the obstacles were copied, as the page does when a cell is painted
+static void RunReplanBenchmarks(const BenchOptions& options, std::vector<BenchResult>& results) {
+    for (const sf::Vector2i& size : options.sizes) {
+        if (static_cast<long long>(size.x) * size.y > MAX_REPLAN_CELLS) {
+            continue;
+        }
+        for (double density : options.densities) {
+            std::string map_name = "random-" + FormatDensity(density);
+            if (!Selected(options, "replan/dstar-lite/" + map_name + "/" + SizeName(size)) && !Selected(options, "replan/astar/" + map_name + "/" + SizeName(size))) {
+                continue;
+            }
+            Grid<CellState> grid = MakeRandomGrid(size, density);
+            sf::Vector2i start(0, 0);
+            sf::Vector2i end(size.x - 1, size.y - 1);
+            IncrementalPlanner planner;
+            planner.setObstacles(grid);
+            planner.setStart(start);
+            planner.setEnd(end);
+            planner.ComputeShortestPath();
+            std::vector<sf::Vector2i> path = planner.FindPath();
+            if (path.size() < 3) {
+                continue;
+            }
+            std::vector<sf::Vector2i> edits;
+            std::mt19937 generator(777);
+            std::uniform_int_distribution<size_t> distribution(1, path.size() - 2);
+            for (int i = 0; i < REPLAN_EDITS; i++) {
+                edits.push_back(path[distribution(generator)]);
+            }
+
+            for (const std::string algorithm : { "dstar-lite", "astar" }) {
+                BenchResult result;
+                result.name = "replan/" + algorithm + "/" + map_name + "/" + SizeName(size);
+                if (!Selected(options, result.name)) {
+                    continue;
+                }
+                result.family = "replan";
+                result.algorithm = algorithm;
+                result.map = "random";
+                result.width = size.x;
+                result.height = size.y;
+                result.density = density;
+                result.queries = 2 * REPLAN_EDITS;
+                Grid<CellState> edited = grid;
+                UnweightedGraph graph(grid, start, end);
+                // Every edit is undone, so the planner is back at the first path after every repetition
+                auto replan = [&](const sf::Vector2i& cell, const CellState& state) {
+                    edited(cell.x, cell.y) = state;
+                    if (algorithm == "dstar-lite") {
+                        planner.UpdateCell(cell.x, cell.y, state);
+                        planner.ComputeShortestPath();
+                        return planner.getExpansions();
+                    }
+                    graph.setObstacles(edited);
+                    return RunGridSearch(graph, "astar");
+                };
+                Measure(options, result, [&]() {
+                    long long expansions = 0;
+                    for (size_t i = 0; i < edits.size(); i++) {
+                        expansions += replan(edits[i], Obstacle);
+                    }
+                    for (size_t i = edits.size(); i-- > 0;) {
+                        expansions += replan(edits[i], Empty);
+                    }
+                    return expansions;
+                });
+                result.bytes_per_cell = static_cast<double>(algorithm == "dstar-lite" ? planner.getMemoryUsage() : graph.getMemoryUsage()) / grid.getSize();
+                Report(result, results);
+            }
+        }
+    }
+}
+
+static void RunMazeBenchmarks(const BenchOptions& options, std::vector<BenchResult>& results) {
+    for (const sf::Vector2i& size : options.sizes) {
+        for (const std::string type : { "random", "backtracker" }) {
+            BenchResult result;
+            result.name = "maze/" + type + "/" + SizeName(size);
+            if (!Selected(options, result.name)) {
+                continue;
+            }
+            result.family = "maze";
+            result.algorithm = type;
+            result.map = type;
+            result.width = size.x;
+            result.height = size.y;
+            RandomMaze maze(size.y, size.x);
+            Measure(options, result, [&]() { return GenerateMaze(maze, type, size); });
+            Report(result, results);
+        }
+    }
+}
+
+static void RunGraphBenchmarks(const BenchOptions& options, std::vector<BenchResult>& results) {
+    ThreadPool pool(options.threads);
+    for (int vertex_count : options.graph_sizes) {
+        for (const std::string map : { "random", "road" }) {
+            WeightedGraph graph;
+            Landmarks landmarks;
+            ContractionHierarchy hierarchy;
+            DistanceMatrix matrix;
+            bool created = false;
+            for (const std::string algorithm : { "dijkstra", "delta-stepping", "astar", "astar-alt", "bellman-ford", "spfa", "ch", "johnson", "floyd-warshall" }) {
+                BenchResult result;
+                result.name = "graph/" + algorithm + "/" + map + "/" + std::to_string(vertex_count);
+                if (!Selected(options, result.name)) {
+                    continue;
+                }
+                if (algorithm == "bellman-ford" && vertex_count > options.max_bellman_ford_vertices) {
+                    continue;
+                }
+                if ((algorithm == "johnson" || algorithm == "floyd-warshall") && vertex_count > options.max_all_pairs_vertices) {
+                    continue;
+                }
+                // Contracting a random graph leaves a dense core of long shortcuts, the hierarchy only pays off on road-like graphs
+                if (algorithm == "ch" && map == "random") {
+                    continue;
+                }
+                if (!created) {
+                    if (map == "random") {
+                        MakeRandomGraph(graph, vertex_count);
+                    }
+                    else {
+                        MakeRoadGraph(graph, vertex_count);
+                    }
+                    graph.Freeze();
+                    created = true;
+                }
+                result.family = "graph";
+                result.algorithm = algorithm;
+                result.map = map;
+                result.width = graph.getVertexCount();
+                result.height = 1;
+                if (algorithm == "ch") {
+                    // The hierarchy is built once per graph and is not timed, only the query from the first to the last vertex
+                    hierarchy.Build(graph);
+                    int target = graph.getVertexCount() - 1;
+                    Measure(options, result, [&]() { hierarchy.Query(0, target); return hierarchy.getExpansions(); });
+                    result.bytes_per_cell = static_cast<double>(hierarchy.getMemoryUsage()) / graph.getVertexCount();
+                    Report(result, results);
+                    continue;
+                }
+                if (algorithm == "johnson" || algorithm == "floyd-warshall") {
+                    // The whole matrix is built per repetition, every vertex is expanded once per source
+                    Measure(options, result, [&]() {
+                        if (algorithm == "johnson") {
+                            matrix.BuildJohnson(graph, pool);
+                        }
+                        else {
+                            matrix.BuildFloydWarshall(graph, pool);
+                        }
+                        return static_cast<long long>(vertex_count) * vertex_count;
+                    });
+                    result.bytes_per_cell = static_cast<double>(matrix.getMemoryUsage()) / graph.getVertexCount();
+                    Report(result, results);
+                    continue;
+                }
+                if (algorithm == "delta-stepping") {
+                    Measure(options, result, [&]() { graph.RunDeltaStepping(pool); return graph.getExpansions(); });
+                    result.bytes_per_cell = static_cast<double>(graph.getMemoryUsage()) / graph.getVertexCount();
+                    Report(result, results);
+                    continue;
+                }
+                // A* runs to the last vertex, without a heuristic it is Dijkstra stopping at the target
+                if (algorithm == "astar-alt" && landmarks.getCount() == 0) {
+                    landmarks.Build(graph, BENCH_LANDMARKS);
+                }
+                graph.setLandmarks(algorithm == "astar-alt" ? &landmarks : nullptr);
+                Measure(options, result, [&]() { return RunGraphAlgorithm(graph, algorithm); });
+                result.bytes_per_cell = static_cast<double>(graph.getMemoryUsage()) / graph.getVertexCount();
+                Report(result, results);
+            }
+        }
+    }
+}
+
+/// \struct ScenarioAlgorithm
+/// \brief A grid search replayed on the scenarios, and what its lengths are checked against.
+struct ScenarioAlgorithm {
+    std::string name;   ///< The name of the search.
+    bool diagonal;      ///< True if it runs with the diagonal moves and is checked against the optimal length of the scenario.
+    bool optimal;       ///< True if every path it finds has to be a shortest one, a mismatch fails the run.
+};
+
+// The searches with straight moves only are checked against the lengths of Breadth First Search with straight moves
+static const std::vector<ScenarioAlgorithm>& ScenarioAlgorithms() {
+    static const std::vector<ScenarioAlgorithm> algorithms = {
+        { "bfs", true, false }, { "dfs", true, false }, { "dijkstra", true, true }, { "astar", true, true }, { "gbfs", true, false },
+        { "jps", false, true }, { "jps-plus", false, true }, { "bitboard-bfs", false, true }, { "bidirectional-bfs", false, true },
+        { "bidirectional-dijkstra", false, true }, { "bidirectional-astar", false, true }, { "hpa", false, false } };
+    return algorithms;
+}
+
+/// \struct ScenarioTotals
+/// \brief The sums over the queries of one bucket, kept by every worker and added up after the run.
+struct ScenarioTotals {
+    int queries = 0;            ///< Queries run.
+    long long mismatches = 0;   ///< Queries whose length is not the optimal one.
+    long long expansions = 0;   ///< Cells (and abstract nodes of hpa) expanded.
+    double time_ns = 0.0;       ///< Time of the searches, without checking the lengths.
+};
+
+// Finds the map of a scenario in the map directory, or next to the scenario file by the name it gives and by its file name
+static std::string FindScenarioMap(const BenchOptions& options, const std::string& scenario_path, const std::string& map) {
+    std::string file_name = map.substr(map.find_last_of("/\\") + 1);
+    if (!options.map_directory.empty()) {
+        return options.map_directory + "/" + file_name;
+    }
+    size_t separator = scenario_path.find_last_of("/\\");
+    std::string directory = separator == std::string::npos ? "." : scenario_path.substr(0, separator);
+    if (std::ifstream(directory + "/" + map)) {
+        return directory + "/" + map;
+    }
+    return directory + "/" + file_name;
+}
+
+// Lengths of the shortest paths of the queries with straight moves, the reference of the searches which have no diagonal moves
+static std::vector<double> StraightLengths(const Grid<CellState>& grid, const std::vector<ScenarioQuery>& queries, ThreadPool& pool) {
+    std::vector<double> lengths(queries.size(), -1.0);
+    std::atomic<size_t> next(0);
+    pool.Run([&](int) {
+        UnweightedGraph graph(grid, { 0, 0 }, { 0, 0 });
+        for (size_t i = next++; i < queries.size(); i = next++) {
+            graph.setStart(queries[i].start);
+            graph.setEnd(queries[i].end);
+            graph.SetUpBFS();
+            graph.RunToCompletion();
+            if (graph.getDistance(queries[i].end) != INT_MAX) {
+                lengths[i] = graph.getDistance(queries[i].end) / static_cast<double>(graph.getStraightCost());
+            }
+        }
+    });
+    return lengths;
+}
+
+// Replays the queries of every scenario with every grid search on all threads, the workers take the queries one by one. A result
+// is written per search, map and bucket, its time is the sum of the times of its queries
+static bool RunScenarioBenchmarks(const BenchOptions& options, std::vector<BenchResult>& results) {
+    ThreadPool pool(options.threads);
+    for (const std::string& scenario_path : options.scenario_paths) {
+        std::vector<ScenarioQuery> scenario;
+        if (!MapLoader::LoadMovingAIScenario(scenario_path, scenario)) {
+            return false;
+        }
+        // A scenario file usually names one map, the queries are grouped by it in the order of the file
+        std::map<std::string, std::vector<ScenarioQuery>> maps;
+        for (const ScenarioQuery& query : scenario) {
+            maps[query.map].push_back(query);
+        }
+
+        for (const auto& map : maps) {
+            std::string map_name = map.first.substr(map.first.find_last_of("/\\") + 1);
+            map_name = map_name.substr(0, map_name.rfind(".map"));
+            const std::vector<ScenarioQuery>& queries = map.second;
+            bool any_selected = false;
+            for (const ScenarioAlgorithm& algorithm : ScenarioAlgorithms()) {
+                any_selected |= Selected(options, "scenario/" + algorithm.name + "/" + map_name);
+            }
+            if (!any_selected) {
+                continue;
+            }
+
+            Grid<CellState> grid;
+            if (!MapLoader::LoadMovingAIMap(FindScenarioMap(options, scenario_path, map.first), grid)) {
+                return false;
+            }
+            for (const ScenarioQuery& query : queries) {
+                if (query.width != grid.getWidth() || query.height != grid.getHeight() || !grid.InBounds(query.start.x, query.start.y)
+                    || !grid.InBounds(query.end.x, query.end.y)) {
+                    std::cerr << "A query of " << scenario_path << " does not fit the map " << map.first << std::endl;
+                    return false;
+                }
+            }
+            std::vector<double> straight_lengths;
+
+            for (const ScenarioAlgorithm& algorithm : ScenarioAlgorithms()) {
+                if (!Selected(options, "scenario/" + algorithm.name + "/" + map_name)) {
+                    continue;
+                }
+                if (!algorithm.diagonal && straight_lengths.empty()) {
+                    straight_lengths = StraightLengths(grid, queries, pool);
+                }
+
+                std::vector<std::map<int, ScenarioTotals>> worker_totals(pool.getThreadCount());
+                std::atomic<size_t> next(0);
+                ResetPeakMemory();
+                pool.Run([&](int worker) {
+                    std::map<int, ScenarioTotals>& totals = worker_totals[worker];
+                    UnweightedGraph graph(grid, { 0, 0 }, { 0, 0 });
+                    graph.setConnectivity(algorithm.diagonal ? Connectivity::Eight : Connectivity::Four, CornerCutting::Forbid);
+                    HierarchicalGraph hierarchy;
+                    // The abstraction and the jump distances are built once per map and worker, they are not timed
+                    if (algorithm.name == "hpa") {
+                        hierarchy.setObstacles(grid);
+                    }
+                    else if (algorithm.name == "jps-plus") {
+                        graph.SetUpJPSPlus();
+                    }
+                    for (size_t i = next++; i < queries.size(); i = next++) {
+                        const ScenarioQuery& query = queries[i];
+                        double length = -1.0;
+                        long long expansions = 0;
+                        auto begin = std::chrono::steady_clock::now();
+                        if (algorithm.name == "hpa") {
+                            std::vector<sf::Vector2i> path = hierarchy.FindPath(query.start, query.end);
+                            expansions = hierarchy.getExpansions();
+                            if (!path.empty()) {
+                                length = static_cast<double>(path.size() - 1);
+                            }
+                        }
+                        else {
+                            graph.setStart(query.start);
+                            graph.setEnd(query.end);
+                            expansions = RunGridSearch(graph, algorithm.name);
+                            if (graph.getDistance(query.end) != INT_MAX) {
+                                length = graph.getDistance(query.end) / static_cast<double>(graph.getStraightCost());
+                            }
+                        }
+                        double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+                        double optimal = algorithm.diagonal ? query.optimal_length : straight_lengths[i];
+                        ScenarioTotals& bucket = totals[query.bucket];
+                        bucket.queries++;
+                        bucket.mismatches += std::abs(length - optimal) > SCENARIO_TOLERANCE * std::max(1.0, optimal);
+                        bucket.expansions += expansions;
+                        bucket.time_ns += time;
+                    }
+                });
+                long long peak_memory_kb = PeakMemoryKB();
+
+                std::map<int, ScenarioTotals> totals;
+                for (const auto& worker : worker_totals) {
+                    for (const auto& bucket : worker) {
+                        ScenarioTotals& sum = totals[bucket.first];
+                        sum.queries += bucket.second.queries;
+                        sum.mismatches += bucket.second.mismatches;
+                        sum.expansions += bucket.second.expansions;
+                        sum.time_ns += bucket.second.time_ns;
+                    }
+                }
+                for (const auto& bucket : totals) {
+                    BenchResult result;
+                    result.name = "scenario/" + algorithm.name + "/" + map_name + "/" + std::to_string(bucket.first);
+                    result.family = "scenario";
+                    result.algorithm = algorithm.name;
+                    result.map = map_name;
+                    result.width = grid.getWidth();
+                    result.height = grid.getHeight();
+                    result.repetitions = 1;
+                    result.time_ns = bucket.second.time_ns;
+                    result.expansions = bucket.second.expansions;
+                    result.peak_memory_kb = peak_memory_kb;
+                    result.queries = bucket.second.queries;
+                    result.mismatches = bucket.second.mismatches;
+                    std::cerr << result.name << ": " << result.time_ns / result.queries / 1e3 << " us per query, "
+                        << result.expansions / result.queries << " expansions per query, " << result.mismatches << " mismatches" << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// A scenario run fails if a search which has to find shortest paths found a longer one
+static bool CheckScenarioLengths(const std::vector<BenchResult>& results) {
+    bool optimal = true;
+    for (const BenchResult& result : results) {
+        if (result.family != "scenario" || result.mismatches == 0) {
+            continue;
+        }
+        for (const ScenarioAlgorithm& algorithm : ScenarioAlgorithms()) {
+            if (algorithm.name == result.algorithm && algorithm.optimal) {
+                std::cerr << result.name << " found " << result.mismatches << " paths which are not the shortest ones" << std::endl;
+                optimal = false;
+            }
+        }
+    }
+    return optimal;
+}
+
+static void WriteResults(std::ostream& output, const std::vector<BenchResult>& results) {
+    output << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        double expansions = static_cast<double>(std::max(result.expansions, 1LL));
+        char line[1024];
+        std::snprintf(line, sizeof(line),
+            "    {\"name\": \"%s\", \"family\": \"%s\", \"algorithm\": \"%s\", \"map\": \"%s\", \"width\": %d, \"height\": %d, "
+            "\"density\": %.2f, \"repetitions\": %d, \"time_ns\": %.0f, \"expansions\": %lld, "
+            "\"expansions_per_second\": %.1f, \"ns_per_expansion\": %.3f, \"peak_memory_kb\": %lld, \"bytes_per_cell\": %.2f, "
+            "\"queries\": %d, \"us_per_query\": %.3f, \"mismatches\": %lld}%s\n",
+            result.name.c_str(), result.family.c_str(), result.algorithm.c_str(), result.map.c_str(), result.width, result.height,
+            result.density, result.repetitions, result.time_ns, result.expansions,
+            expansions / (result.time_ns / 1e9), result.time_ns / expansions, result.peak_memory_kb, result.bytes_per_cell,
+            result.queries, result.time_ns / result.queries / 1e3, result.mismatches, i + 1 < results.size() ? "," : "");
+        output << line;
+    }
+    output << "  ]\n}\n";
+}
+
+// The same fields as the JSON results, one row per benchmark
+static void WriteCsv(std::ostream& output, const std::vector<BenchResult>& results) {
+    output << "name,family,algorithm,map,width,height,density,repetitions,time_ns,expansions,expansions_per_second,ns_per_expansion,"
+        "peak_memory_kb,bytes_per_cell,queries,us_per_query,mismatches\n";
+    for (const BenchResult& result : results) {
+        double expansions = static_cast<double>(std::max(result.expansions, 1LL));
+        char line[1024];
+        std::snprintf(line, sizeof(line), "%s,%s,%s,%s,%d,%d,%.2f,%d,%.0f,%lld,%.1f,%.3f,%lld,%.2f,%d,%.3f,%lld\n",
+            result.name.c_str(), result.family.c_str(), result.algorithm.c_str(), result.map.c_str(), result.width, result.height,
+            result.density, result.repetitions, result.time_ns, result.expansions, expansions / (result.time_ns / 1e9),
+            result.time_ns / expansions, result.peak_memory_kb, result.bytes_per_cell, result.queries,
+            result.time_ns / result.queries / 1e3, result.mismatches);
+        output << line;
+    }
+}
+
+// Reads the name and the time per expansion of every benchmark of a stored run, the results are one object per line
+static std::map<std::string, double> LoadBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t name = line.find("\"name\": \"");
+        size_t time = line.find("\"ns_per_expansion\": ");
+        if (name == std::string::npos || time == std::string::npos) {
+            continue;
+        }
+        name += 9;
+        size_t name_end = line.find('"', name);
+        baseline[line.substr(name, name_end - name)] = std::stod(line.substr(time + 20));
+    }
+    return baseline;
+}
+
+static bool CompareWithBaseline(const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::map<std::string, double> baseline = LoadBaseline(options.baseline_path);
+    if (baseline.empty()) {
+        std::cerr << "The baseline " << options.baseline_path << " has no benchmarks" << std::endl;
+        return false;
+    }
+
+    bool regressed = false;
+    for (const auto& result : results) {
+        auto stored = baseline.find(result.name);
+        if (stored == baseline.end()) {
+            continue;
+        }
+        double current = result.time_ns / static_cast<double>(std::max(result.expansions, 1LL));
+        double change = (current - stored->second) / stored->second;
+        bool slower = change > options.threshold;
+        regressed |= slower;
+        char line[512];
+        std::snprintf(line, sizeof(line), "%-48s %10.3f -> %10.3f ns/expansion %+7.1f%%%s",
+            result.name.c_str(), stored->second, current, change * 100.0, slower ? "  REGRESSION" : "");
+        std::cerr << line << std::endl;
+    }
+    return !regressed;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+    if (!options.scenario_paths.empty()) {
+        if (!RunScenarioBenchmarks(options, results)) {
+            return 1;
+        }
+    }
+    else {
+        RunGridBenchmarks(options, results);
+        RunReplanBenchmarks(options, results);
+        RunMazeBenchmarks(options, results);
+        RunGraphBenchmarks(options, results);
+    }
+
+    if (options.output_path.empty()) {
+        WriteResults(std::cout, results);
+    }
+    else {
+        std::ofstream output(options.output_path);
+        if (!output) {
+            std::cerr << "Could not write " << options.output_path << std::endl;
+            return 1;
+        }
+        WriteResults(output, results);
+    }
+    if (!options.csv_path.empty()) {
+        std::ofstream csv(options.csv_path);
+        if (!csv) {
+            std::cerr << "Could not write " << options.csv_path << std::endl;
+            return 1;
+        }
+        WriteCsv(csv, results);
+    }
+
+    if (!CheckScenarioLengths(results)) {
+        return 1;
+    }
+
+    if (!options.baseline_path.empty() && !CompareWithBaseline(options, results)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "../headers/BitboardBFS.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+BitboardBFS::BitboardBFS() : width(0), height(0), tile_rows(0), blocks_per_row(0), stride(0), depth(0) {}
+
+BitboardBFS::BitboardBFS(const Grid<CellState>& obstacles) : BitboardBFS() {
+	setObstacles(obstacles);
+}
+
+void BitboardBFS::setObstacles(const Grid<CellState>& obstacles) {
+	width = obstacles.getWidth();
+	height = obstacles.getHeight();
+	tile_rows = (height + 7) / 8;
+	blocks_per_row = ((width + 7) / 8 + BLOCK_TILES - 1) / BLOCK_TILES;
+	stride = blocks_per_row * BLOCK_TILES + 2;
+	size_t size = static_cast<size_t>(stride) * (tile_rows + 2);
+
+	free_cells.assign(size, 0);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			if (obstacles(x, y) != Obstacle) {
+				free_cells[TileOffset(x, y)] |= uint64_t(1) << ((y % 8) * 8 + x % 8);
+			}
+		}
+	}
+	visited.assign(size, 0);
+	frontier.assign(size, 0);
+	next_frontier.assign(size, 0);
+
+	active_blocks.clear();
+	next_blocks.clear();
+	candidates.clear();
+	candidate.assign(static_cast<size_t>(tile_rows + 2) * blocks_per_row, false);
+	depth = 0;
+}
+
+void BitboardBFS::Start(const sf::Vector2i& start) {
+	// Only the blocks of the last frontier can be dirty
+	for (int block : active_blocks) {
+		std::fill_n(frontier.begin() + BlockOffset(block), BLOCK_TILES, 0);
+	}
+	active_blocks.clear();
+	std::fill(visited.begin(), visited.end(), 0);
+	depth = 0;
+
+	if (start.x < 0 || start.y < 0 || start.x >= width || start.y >= height) {
+		return;
+	}
+	uint64_t bit = uint64_t(1) << ((start.y % 8) * 8 + start.x % 8);
+	visited[TileOffset(start.x, start.y)] |= bit;
+	frontier[TileOffset(start.x, start.y)] |= bit;
+	active_blocks.push_back((start.y / 8 + 1) * blocks_per_row + start.x / (8 * BLOCK_TILES));
+}
+
+void BitboardBFS::AddCandidate(const int& block) {
+	if (!candidate[block]) {
+		candidate[block] = true;
+		candidates.push_back(block);
+	}
+}
+
+long long BitboardBFS::ExpandBlock(const int& block) {
+	const uint64_t FIRST_COLUMN = 0x0101010101010101ULL; // The cells with x % 8 == 0 of a tile
+	const uint64_t LAST_COLUMN = 0x8080808080808080ULL;  // The cells with x % 8 == 7 of a tile
+
+	size_t offset = BlockOffset(block);
+	const uint64_t* current = &frontier[offset];
+	const uint64_t* above = current - stride;
+	const uint64_t* below = current + stride;
+	const uint64_t* free_block = &free_cells[offset];
+	uint64_t* visited_block = &visited[offset];
+	uint64_t* next_block = &next_frontier[offset];
+
+	// Inside a tile the frontier moves by one bit horizontally and by eight bits vertically, the cells on the border
+	// of the tile come from the last column or row of the neighbouring tile
+#if defined(__AVX2__)
+	// The left and right neighbours of the four tiles are the unaligned loads shifted by one tile
+	const __m256i first_column = _mm256_set1_epi64x(static_cast<long long>(FIRST_COLUMN));
+	const __m256i last_column = _mm256_set1_epi64x(static_cast<long long>(LAST_COLUMN));
+	__m256i middle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+	__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current - 1));
+	__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + 1));
+	__m256i up = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(above));
+	__m256i down = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(below));
+
+	__m256i spread = _mm256_or_si256(middle, _mm256_or_si256(_mm256_slli_epi64(middle, 8), _mm256_srli_epi64(middle, 8)));
+	spread = _mm256_or_si256(spread, _mm256_andnot_si256(first_column, _mm256_slli_epi64(middle, 1)));
+	spread = _mm256_or_si256(spread, _mm256_andnot_si256(last_column, _mm256_srli_epi64(middle, 1)));
+	spread = _mm256_or_si256(spread, _mm256_srli_epi64(_mm256_and_si256(left, last_column), 7));
+	spread = _mm256_or_si256(spread, _mm256_slli_epi64(_mm256_and_si256(right, first_column), 7));
+	spread = _mm256_or_si256(spread, _mm256_or_si256(_mm256_srli_epi64(up, 56), _mm256_slli_epi64(down, 56)));
+
+	__m256i seen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited_block));
+	__m256i reached = _mm256_andnot_si256(seen, _mm256_and_si256(spread, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(free_block))));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(next_block), reached);
+	if (_mm256_testz_si256(reached, reached)) {
+		return 0;
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(visited_block), _mm256_or_si256(seen, reached));
+#else
+	for (int t = 0; t < BLOCK_TILES; t++) {
+		uint64_t middle = current[t];
+		uint64_t spread = middle | (middle << 8) | (middle >> 8) | ((middle << 1) & ~FIRST_COLUMN) | ((middle >> 1) & ~LAST_COLUMN)
+			| ((current[t - 1] & LAST_COLUMN) >> 7) | ((current[t + 1] & FIRST_COLUMN) << 7) | (above[t] >> 56) | (below[t] << 56);
+		uint64_t reached = spread & free_block[t] & ~visited_block[t];
+		next_block[t] = reached;
+		visited_block[t] |= reached;
+	}
+#endif
+
+	long long count = 0;
+	for (int t = 0; t < BLOCK_TILES; t++) {
+		count += PopCount(next_block[t]);
+	}
+	return count;
+}
+
+long long BitboardBFS::Step() {
+	if (active_blocks.empty()) {
+		return 0;
+	}
+
+	// The next wavefront can only reach the blocks of the frontier and the blocks next to them
+	for (int block : active_blocks) {
+		int row = block / blocks_per_row;
+		int column = block % blocks_per_row;
+		AddCandidate(block);
+		if (column > 0) AddCandidate(block - 1);
+		if (column < blocks_per_row - 1) AddCandidate(block + 1);
+		if (row > 1) AddCandidate(block - blocks_per_row);
+		if (row < tile_rows) AddCandidate(block + blocks_per_row);
+	}
+
+	long long reached = 0;
+	next_blocks.clear();
+	for (int block : candidates) {
+		candidate[block] = false;
+		long long count = ExpandBlock(block);
+		if (count > 0) {
+			reached += count;
+			next_blocks.push_back(block);
+		}
+	}
+	candidates.clear();
+
+	// Clear the old frontier, so the boards stay zero outside of the active blocks
+	for (int block : active_blocks) {
+		std::fill_n(frontier.begin() + BlockOffset(block), BLOCK_TILES, 0);
+	}
+	frontier.swap(next_frontier);
+	active_blocks.swap(next_blocks);
+	if (reached > 0) {
+		depth++;
+	}
+	return reached;
+}
+
+long long BitboardBFS::Run(const sf::Vector2i& start, Grid<int>& distances) {
+	distances.Resize(width, height, INT_MAX);
+	Start(start);
+	if (active_blocks.empty()) {
+		return 0;
+	}
+	distances(start.x, start.y) = 0;
+	long long reached = 1;
+	long long count;
+	while ((count = Step()) > 0) {
+		reached += count;
+		ForEachFrontierCell([&](const int& x, const int& y) {
+			distances(x, y) = depth;
+		});
+	}
+	return reached;
+}
+
+bool BitboardBFS::IsVisited(const int& x, const int& y) const {
+	return (visited[TileOffset(x, y)] >> ((y % 8) * 8 + x % 8)) & 1;
+}
+
+int BitboardBFS::getDepth() const {
+	return depth;
+}
+
+int BitboardBFS::getWidth() const {
+	return width;
+}
+
+int BitboardBFS::getHeight() const {
+	return height;
+}
+
+size_t BitboardBFS::getMemoryUsage() const {
+	return (free_cells.size() + visited.size() + frontier.size() + next_frontier.size()) * sizeof(uint64_t)
+		+ (active_blocks.capacity() + next_blocks.capacity() + candidates.capacity()) * sizeof(int) + candidate.size();
+}
@@ -0,0 +1,82 @@
+#include "../headers/BucketQueue.hpp"
+#include <climits>
+#include <algorithm>
+
+#define INITIAL_BUCKETS 8 // Enough for the unit cost searches, the keys pushed are at most two ahead of the smallest one
+
+BucketQueue::BucketQueue() : buckets(INITIAL_BUCKETS), mask(INITIAL_BUCKETS - 1), top_key(INT_MAX), max_key(INT_MIN), count(0) {}
+
+void BucketQueue::Clear() {
+	if (count > 0) {
+		for (auto& bucket : buckets) {
+			bucket.clear();
+		}
+	}
+	top_key = INT_MAX;
+	max_key = INT_MIN;
+	count = 0;
+}
+
+void BucketQueue::Push(const int& key, const uint32_t& cell) {
+	// The first key pushed into an empty queue becomes the smallest one, the cells pushed after it while the same cell is
+	// expanded may have smaller keys, then the ring is moved down to them
+	if (count == 0) {
+		top_key = key;
+		max_key = key;
+	}
+	else if (key < top_key) {
+		Grow(key, max_key);
+	}
+	else if (key - top_key > mask) {
+		Grow(top_key, key);
+	}
+	max_key = std::max(max_key, key);
+	buckets[key & mask].push_back(cell);
+	count++;
+}
+
+void BucketQueue::FindTop() {
+	while (buckets[top_key & mask].empty()) {
+		top_key++;
+	}
+}
+
+int BucketQueue::TopKey() {
+	FindTop();
+	return top_key;
+}
+
+uint32_t BucketQueue::Top() {
+	FindTop();
+	return buckets[top_key & mask].back();
+}
+
+void BucketQueue::Pop() {
+	FindTop();
+	buckets[top_key & mask].pop_back();
+	count--;
+}
+
+bool BucketQueue::empty() const {
+	return count == 0;
+}
+
+size_t BucketQueue::size() const {
+	return count;
+}
+
+void BucketQueue::Grow(const int& low, const int& high) {
+	int size = mask + 1;
+	while (high - low >= size) {
+		size *= 2;
+	}
+	// Every key in the queue lies in [top_key, max_key], so the buckets are moved by their keys. The ring is sized by the keys
+	// queued, not by its old size, so a key below the smallest one only grows it as far as the keys really spread
+	std::vector<std::vector<uint32_t>> grown(size);
+	for (int k = top_key; k <= max_key; k++) {
+		grown[k & (size - 1)].swap(buckets[k & mask]);
+	}
+	buckets.swap(grown);
+	mask = size - 1;
+	top_key = low;
+}
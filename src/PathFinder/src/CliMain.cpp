@@ -0,0 +1,960 @@
+#include "../headers/UnweightedGraph.hpp"
+#include "../headers/WeightedGraph.hpp"
+#include "../headers/MapLoader.hpp"
+#include "../headers/HierarchicalGraph.hpp"
+#include "../headers/Landmarks.hpp"
+#include "../headers/ContractionHierarchy.hpp"
+#include "../headers/ThreadPool.hpp"
+#include "../headers/DistanceMatrix.hpp"
+#include "../headers/QueryServer.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cctype>
+#include <map>
+#include <memory>
+
+// Headless solver: loads a grid or a weighted graph from a file, runs the chosen algorithm
+// to completion for every query and prints the path length, cost, expansions and wall time.
+// With --serve the map and its preprocessing stay loaded and the queries come as JSON lines.
+
+enum class CliAlgorithm {
+    BFS,
+    DFS,
+    Dijkstra,
+    AStar,
+    GBFS,
+    JPS,
+    JPSPlus,
+    BitboardBFS,
+    BidirectionalBFS,
+    BidirectionalDijkstra,
+    BidirectionalAStar,
+    HPA,
+    BellmanFord,
+    CH,
+    DeltaStepping,
+    SPFA,
+    Johnson,
+    FloydWarshall,
+    AllPairs
+};
+
+struct CliOptions {
+    std::string grid_path;
+    std::string graph_path;
+    std::string queries_path;
+    std::string algorithm_name = "astar";
+    CliAlgorithm algorithm = CliAlgorithm::AStar;
+    sf::Vector2i start = { -1, -1 };
+    sf::Vector2i end = { -1, -1 };
+    int source = 0;
+    int target = -1;
+    Connectivity connectivity = Connectivity::Four;
+    CornerCutting corner_cutting = CornerCutting::Forbid;
+    int cluster_size = 16;
+    int landmark_count = 0;
+    LandmarkSelection landmark_selection = LandmarkSelection::Farthest;
+    std::string landmark_path;
+    std::string hierarchy_path;
+    int threads = 0;
+    int delta = 0;
+    int floyd_warshall_limit = FLOYD_WARSHALL_LIMIT;
+    std::string serve_path;
+};
+
+static void PrintUsage() {
+    std::cerr << "Usage: pathfinder-cli (--grid FILE | --graph FILE) [options]\n"
+        << "  --grid FILE          Grid file, '.' empty, '#' obstacle, 'S' start, 'E' end, or a MovingAI map (.map)\n"
+        << "  --graph FILE         Edge list file, one \"from to weight\" per line, or a DIMACS graph (.gr)\n"
+        << "  --algorithm NAME     Grid: bfs, dfs, dijkstra, astar, gbfs, jps, jps-plus, bitboard-bfs,\n"
+        << "                       bidirectional-bfs, bidirectional-dijkstra, bidirectional-astar, hpa\n"
+        << "                       Graph: bfs, dfs, dijkstra, astar, bellman-ford, spfa, ch, delta-stepping,\n"
+        << "                       johnson, floyd-warshall, all-pairs\n"
+        << "  --start X,Y          Start cell of a grid query\n"
+        << "  --end X,Y            End cell of a grid query\n"
+        << "  --moves 4|8          Straight moves only (default) or diagonal moves too, for bfs, dfs, dijkstra, astar and gbfs\n"
+        << "  --corner-cutting M   Diagonal moves past obstacles: allow, forbid-both-blocked or forbid (default)\n"
+        << "  --cluster-size N     Side length of the clusters of hpa (default 16)\n"
+        << "  --landmarks K        Build K landmarks, A* and the searches with straight moves use their lower bounds (ALT)\n"
+        << "  --landmark-selection S  Placement of the landmarks: farthest (default) or avoid\n"
+        << "  --landmark-file FILE Map the landmarks from FILE, or write the built ones to it when --landmarks is given\n"
+        << "  --hierarchy-file FILE  Map the contraction hierarchy of ch from FILE, or build it and write it to FILE\n"
+        << "  --threads N          Threads of the graph loader, delta-stepping, the all-pairs algorithms and the workers of --serve\n"
+        << "                       (default one per hardware thread)\n"
+        << "  --delta W            Bucket width of delta-stepping (default the largest weight over the average degree)\n"
+        << "  --floyd-warshall-limit N  Largest graph all-pairs runs Floyd-Warshall on, Johnson above (default 2048)\n"
+        << "  --source V           Source vertex of a graph query (default 0)\n"
+        << "  --target V           Target vertex of a graph query (default the last vertex)\n"
+        << "  --queries FILE       Run every query of the file, \"sx sy ex ey\" (grid) or \"source target\" (graph) per line\n"
+        << "  --serve SOCKET       Keep the map loaded and answer JSON requests, one per line, on a Unix domain socket,\n"
+        << "                       or on the standard input and output with -, on --threads workers\n";
+}
+
+static bool ParsePoint(const std::string& text, sf::Vector2i& point) {
+    size_t comma = text.find(',');
+    if (comma == std::string::npos) {
+        return false;
+    }
+    try {
+        point.x = std::stoi(text.substr(0, comma));
+        point.y = std::stoi(text.substr(comma + 1));
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+// The all-pairs algorithms fill a distance matrix once, the queries only read it
+static bool IsAllPairs(const CliAlgorithm& algorithm) {
+    return algorithm == CliAlgorithm::Johnson || algorithm == CliAlgorithm::FloydWarshall || algorithm == CliAlgorithm::AllPairs;
+}
+
+static bool ParseAlgorithm(const std::string& name, CliAlgorithm& algorithm) {
+    if (name == "bfs") algorithm = CliAlgorithm::BFS;
+    else if (name == "dfs") algorithm = CliAlgorithm::DFS;
+    else if (name == "dijkstra") algorithm = CliAlgorithm::Dijkstra;
+    else if (name == "astar") algorithm = CliAlgorithm::AStar;
+    else if (name == "gbfs") algorithm = CliAlgorithm::GBFS;
+    else if (name == "jps") algorithm = CliAlgorithm::JPS;
+    else if (name == "jps-plus") algorithm = CliAlgorithm::JPSPlus;
+    else if (name == "bitboard-bfs") algorithm = CliAlgorithm::BitboardBFS;
+    else if (name == "bidirectional-bfs") algorithm = CliAlgorithm::BidirectionalBFS;
+    else if (name == "bidirectional-dijkstra") algorithm = CliAlgorithm::BidirectionalDijkstra;
+    else if (name == "bidirectional-astar") algorithm = CliAlgorithm::BidirectionalAStar;
+    else if (name == "hpa") algorithm = CliAlgorithm::HPA;
+    else if (name == "bellman-ford") algorithm = CliAlgorithm::BellmanFord;
+    else if (name == "ch") algorithm = CliAlgorithm::CH;
+    else if (name == "delta-stepping") algorithm = CliAlgorithm::DeltaStepping;
+    else if (name == "spfa") algorithm = CliAlgorithm::SPFA;
+    else if (name == "johnson") algorithm = CliAlgorithm::Johnson;
+    else if (name == "floyd-warshall") algorithm = CliAlgorithm::FloydWarshall;
+    else if (name == "all-pairs") algorithm = CliAlgorithm::AllPairs;
+    else return false;
+    return true;
+}
+
+static bool ParseCornerCutting(const std::string& name, CornerCutting& corner_cutting) {
+    if (name == "allow") corner_cutting = CornerCutting::Allow;
+    else if (name == "forbid-both-blocked") corner_cutting = CornerCutting::ForbidIfBothBlocked;
+    else if (name == "forbid") corner_cutting = CornerCutting::Forbid;
+    else return false;
+    return true;
+}
+
+static bool ParseOptions(int argc, char* argv[], CliOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (argument == "--grid") {
+            options.grid_path = value;
+        }
+        else if (argument == "--graph") {
+            options.graph_path = value;
+        }
+        else if (argument == "--queries") {
+            options.queries_path = value;
+        }
+        else if (argument == "--algorithm") {
+            options.algorithm_name = value;
+            if (!ParseAlgorithm(value, options.algorithm)) {
+                std::cerr << "Unknown algorithm " << value << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--start" || argument == "--end") {
+            if (!ParsePoint(value, argument == "--start" ? options.start : options.end)) {
+                std::cerr << "Invalid cell " << value << ", expected X,Y" << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--moves") {
+            if (value != "4" && value != "8") {
+                std::cerr << "Invalid moves " << value << ", expected 4 or 8" << std::endl;
+                return false;
+            }
+            options.connectivity = value == "8" ? Connectivity::Eight : Connectivity::Four;
+        }
+        else if (argument == "--corner-cutting") {
+            if (!ParseCornerCutting(value, options.corner_cutting)) {
+                std::cerr << "Unknown corner cutting " << value << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--cluster-size") {
+            try {
+                options.cluster_size = std::stoi(value);
+            }
+            catch (const std::exception&) {
+                std::cerr << "Invalid cluster size " << value << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--threads" || argument == "--delta" || argument == "--floyd-warshall-limit") {
+            try {
+                (argument == "--threads" ? options.threads : argument == "--delta" ? options.delta : options.floyd_warshall_limit) = std::stoi(value);
+            }
+            catch (const std::exception&) {
+                std::cerr << "Invalid " << argument.substr(2) << " " << value << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--landmarks") {
+            try {
+                options.landmark_count = std::stoi(value);
+            }
+            catch (const std::exception&) {
+                std::cerr << "Invalid landmark count " << value << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--landmark-selection") {
+            if (value != "farthest" && value != "avoid") {
+                std::cerr << "Unknown landmark selection " << value << std::endl;
+                return false;
+            }
+            options.landmark_selection = value == "farthest" ? LandmarkSelection::Farthest : LandmarkSelection::Avoid;
+        }
+        else if (argument == "--landmark-file") {
+            options.landmark_path = value;
+        }
+        else if (argument == "--hierarchy-file") {
+            options.hierarchy_path = value;
+        }
+        else if (argument == "--serve") {
+            options.serve_path = value;
+        }
+        else if (argument == "--source" || argument == "--target") {
+            try {
+                (argument == "--source" ? options.source : options.target) = std::stoi(value);
+            }
+            catch (const std::exception&) {
+                std::cerr << "Invalid vertex " << value << std::endl;
+                return false;
+            }
+        }
+        else {
+            std::cerr << "Unknown option " << argument << std::endl;
+            return false;
+        }
+    }
+    if (options.grid_path.empty() == options.graph_path.empty()) {
+        std::cerr << "Exactly one of --grid and --graph has to be given" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static double ElapsedMicroseconds(const std::chrono::steady_clock::time_point& begin) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Builds the landmarks (and writes them to the landmark file if one is given) or maps them from the landmark file,
+// nothing is done when neither was asked for
+template<typename Graph>
+static bool PrepareLandmarks(const Graph& graph, const CliOptions& options, Landmarks& landmarks) {
+    if (options.landmark_count > 0) {
+        auto begin = std::chrono::steady_clock::now();
+        if (!landmarks.Build(graph, options.landmark_count, options.landmark_selection)) {
+            return false;
+        }
+        std::cerr << "Built " << landmarks.getCount() << " landmarks in " << ElapsedMicroseconds(begin) / 1000.0 << " ms" << std::endl;
+        return options.landmark_path.empty() || landmarks.Save(options.landmark_path);
+    }
+    if (!options.landmark_path.empty()) {
+        return landmarks.Load(options.landmark_path, graph);
+    }
+    return true;
+}
+
+static void SkipJsonSpaces(const std::string& text, size_t& position) {
+    while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\r' || text[position] == '\n')) {
+        position++;
+    }
+}
+
+// Moves past one JSON value, the nested arrays and objects included, false if the text is not valid JSON
+static bool SkipJsonValue(const std::string& text, size_t& position, const int& depth = 0) {
+    SkipJsonSpaces(text, position);
+    if (position >= text.size() || depth > 32) {
+        return false;
+    }
+    char first = text[position];
+    if (first == '"') {
+        for (position++; position < text.size() && text[position] != '"'; position++) {
+            if (text[position] == '\\') {
+                position++;
+            }
+        }
+        return position++ < text.size();
+    }
+    if (first == '[' || first == '{') {
+        char closing = first == '[' ? ']' : '}';
+        position++;
+        SkipJsonSpaces(text, position);
+        if (position < text.size() && text[position] == closing) {
+            position++;
+            return true;
+        }
+        while (true) {
+            if (first == '{' && (!SkipJsonValue(text, position, depth + 1) || (SkipJsonSpaces(text, position), position >= text.size() || text[position++] != ':'))) {
+                return false;
+            }
+            if (!SkipJsonValue(text, position, depth + 1)) {
+                return false;
+            }
+            SkipJsonSpaces(text, position);
+            if (position >= text.size()) {
+                return false;
+            }
+            if (text[position++] == closing) {
+                return true;
+            }
+            if (text[position - 1] != ',') {
+                return false;
+            }
+        }
+    }
+    size_t begin = position;
+    while (position < text.size() && (std::isalnum(static_cast<unsigned char>(text[position])) || text[position] == '-' || text[position] == '+' || text[position] == '.')) {
+        position++;
+    }
+    std::string word = text.substr(begin, position - begin);
+    return word == "true" || word == "false" || word == "null" || (!word.empty() && (std::isdigit(static_cast<unsigned char>(word[0])) || word[0] == '-'));
+}
+
+// Splits a JSON object into its fields, the values are kept as they were written
+static bool ParseJsonObject(const std::string& text, std::map<std::string, std::string>& fields) {
+    size_t position = 0;
+    SkipJsonSpaces(text, position);
+    if (position >= text.size() || text[position++] != '{') {
+        return false;
+    }
+    SkipJsonSpaces(text, position);
+    if (position < text.size() && text[position] == '}') {
+        position++;
+    }
+    else {
+        while (true) {
+            SkipJsonSpaces(text, position);
+            size_t key_begin = position;
+            if (position >= text.size() || text[position] != '"' || !SkipJsonValue(text, position)) {
+                return false;
+            }
+            std::string key = text.substr(key_begin + 1, position - key_begin - 2);
+            SkipJsonSpaces(text, position);
+            if (position >= text.size() || text[position++] != ':') {
+                return false;
+            }
+            SkipJsonSpaces(text, position);
+            size_t value_begin = position;
+            if (!SkipJsonValue(text, position)) {
+                return false;
+            }
+            fields[key] = text.substr(value_begin, position - value_begin);
+            SkipJsonSpaces(text, position);
+            if (position >= text.size()) {
+                return false;
+            }
+            char separator = text[position++];
+            if (separator == '}') {
+                break;
+            }
+            if (separator != ',') {
+                return false;
+            }
+        }
+    }
+    SkipJsonSpaces(text, position);
+    return position == text.size();
+}
+
+// Reads an integer at the position, false if there is none or it does not fit in an int
+static bool ScanJsonInteger(const std::string& text, size_t& position, int& number) {
+    SkipJsonSpaces(text, position);
+    size_t begin = position;
+    if (position < text.size() && text[position] == '-') {
+        position++;
+    }
+    size_t digits = position;
+    while (position < text.size() && std::isdigit(static_cast<unsigned char>(text[position]))) {
+        position++;
+    }
+    if (position == digits || position - digits > 10) {
+        return false;
+    }
+    long long value = std::stoll(text.substr(begin, position - begin));
+    if (value < INT_MIN || value > INT_MAX) {
+        return false;
+    }
+    number = static_cast<int>(value);
+    SkipJsonSpaces(text, position);
+    return true;
+}
+
+static bool ParseJsonInteger(const std::string& value, int& number) {
+    size_t position = 0;
+    return ScanJsonInteger(value, position, number) && position == value.size();
+}
+
+// Reads a cell written as [x, y]
+static bool ParseJsonCell(const std::string& value, sf::Vector2i& cell) {
+    size_t position = 0;
+    if (value.empty() || value[position++] != '[' || !ScanJsonInteger(value, position, cell.x) || position >= value.size() || value[position++] != ','
+        || !ScanJsonInteger(value, position, cell.y)) {
+        return false;
+    }
+    return position + 1 == value.size() && value[position] == ']';
+}
+
+// The id of a request is sent back as it was written, so a client can match the answers of pipelined requests
+static std::string JsonError(const std::map<std::string, std::string>& fields, const std::string& message) {
+    auto id = fields.find("id");
+    return std::string("{") + (id != fields.end() ? "\"id\":" + id->second + "," : "") + "\"error\":\"" + message + "\"}";
+}
+
+static int Serve(const CliOptions& options, ThreadPool& pool, const QueryServer::Handler& handler) {
+    QueryServer server(pool);
+    auto begin = std::chrono::steady_clock::now();
+    if (options.serve_path == "-") {
+        std::cerr << "Answering the standard input with " << pool.getThreadCount() << " workers" << std::endl;
+        server.ServeStandardStreams(handler);
+    }
+    else {
+        std::cerr << "Answering " << options.serve_path << " with " << pool.getThreadCount() << " workers" << std::endl;
+        if (!server.ServeSocket(options.serve_path, handler)) {
+            return 1;
+        }
+    }
+    std::cerr << "Answered " << server.getAnswered() << " requests in " << ElapsedMicroseconds(begin) / 1000000.0 << " s" << std::endl;
+    return 0;
+}
+
+// The answer to a grid query, printed by the solver or sent back by the server
+struct GridAnswer {
+    int length = -1;
+    double cost = -1;
+    long long expansions = 0;
+    double time = 0;
+    std::vector<sf::Vector2i> path;
+};
+
+// The abstraction of hpa is built once for the grid, every query only searches the abstract graph and refines the chosen segments
+static GridAnswer AnswerGridQuery(UnweightedGraph& graph, HierarchicalGraph& hierarchy, const Grid<CellState>& grid, const CliOptions& options, const sf::Vector2i& start, const sf::Vector2i& end) {
+    GridAnswer answer;
+    if (options.algorithm == CliAlgorithm::HPA) {
+        auto begin = std::chrono::steady_clock::now();
+        answer.path = hierarchy.FindPath(start, end);
+        answer.time = ElapsedMicroseconds(begin);
+        answer.length = static_cast<int>(answer.path.size()) - 1;
+        answer.cost = answer.length;
+        answer.expansions = hierarchy.getExpansions();
+        return answer;
+    }
+    graph.setObstacles(grid);
+    graph.setStart(start);
+    graph.setEnd(end);
+
+    auto begin = std::chrono::steady_clock::now();
+    switch (options.algorithm) {
+    case CliAlgorithm::BFS:
+        graph.SetUpBFS();
+        break;
+    case CliAlgorithm::DFS:
+        graph.SetUpDFS();
+        break;
+    case CliAlgorithm::Dijkstra:
+        graph.SetUpDijkstra();
+        break;
+    case CliAlgorithm::AStar:
+        graph.SetUpAStar();
+        break;
+    case CliAlgorithm::GBFS:
+        graph.SetUpGBFS();
+        break;
+    case CliAlgorithm::JPS:
+        graph.SetUpJPS();
+        break;
+    case CliAlgorithm::JPSPlus:
+        graph.SetUpJPSPlus();
+        break;
+    case CliAlgorithm::BitboardBFS:
+        graph.SetUpBitboardBFS();
+        break;
+    case CliAlgorithm::BidirectionalBFS:
+        graph.SetUpBidirectionalBFS();
+        break;
+    case CliAlgorithm::BidirectionalDijkstra:
+        graph.SetUpBidirectionalDijkstra();
+        break;
+    case CliAlgorithm::BidirectionalAStar:
+        graph.SetUpBidirectionalAStar();
+        break;
+    default:
+        break;
+    }
+    graph.RunToCompletion();
+    answer.time = ElapsedMicroseconds(begin);
+    answer.expansions = graph.getExpansions();
+
+    if (graph.getDistance(end) != INT_MAX) {
+        answer.path = graph.TraceShortestPath();
+        answer.length = static_cast<int>(answer.path.size()) - 1;
+        // The distances are fixed-point, a straight move costs 1
+        answer.cost = static_cast<double>(graph.getDistance(end)) / graph.getStraightCost();
+    }
+    return answer;
+}
+
+static void RunGridQuery(UnweightedGraph& graph, HierarchicalGraph& hierarchy, const Grid<CellState>& grid, const CliOptions& options, const sf::Vector2i& start, const sf::Vector2i& end) {
+    if (!grid.InBounds(start.x, start.y) || !grid.InBounds(end.x, end.y)) {
+        std::cerr << "Query " << start.x << "," << start.y << " -> " << end.x << "," << end.y << " is outside of the grid" << std::endl;
+        return;
+    }
+    GridAnswer answer = AnswerGridQuery(graph, hierarchy, grid, options, start, end);
+    std::cout << "algorithm=" << options.algorithm_name
+        << " start=" << start.x << "," << start.y
+        << " end=" << end.x << "," << end.y
+        << " length=" << answer.length
+        << " cost=" << answer.cost
+        << " expansions=" << answer.expansions
+        << " time_us=" << answer.time << std::endl;
+}
+
+// Search state of one worker of the server, the grid, the landmarks and the abstraction are only read by the workers
+struct GridWorker {
+    UnweightedGraph graph;
+    HierarchicalGraph hierarchy;
+
+    GridWorker(const Grid<CellState>& grid, const sf::Vector2i& start, const sf::Vector2i& end) : graph(grid, start, end) {}
+};
+
+// A request is {"id": ..., "start": [x, y], "end": [x, y], "path": true} or a line of a query file, the start and the end of the
+// map are taken for the cells left out
+static std::string AnswerGridRequest(GridWorker& worker, const Grid<CellState>& grid, const CliOptions& options, const sf::Vector2i& start, const sf::Vector2i& end,
+    const std::string& request) {
+    std::map<std::string, std::string> fields;
+    sf::Vector2i query_start = start;
+    sf::Vector2i query_end = end;
+    if (request[0] == '{') {
+        if (!ParseJsonObject(request, fields)) {
+            return JsonError(fields, "The request is not a JSON object");
+        }
+        if ((fields.count("start") && !ParseJsonCell(fields["start"], query_start)) || (fields.count("end") && !ParseJsonCell(fields["end"], query_end))) {
+            return JsonError(fields, "The start and the end are cells written as [x, y]");
+        }
+    }
+    else {
+        std::istringstream stream(request);
+        if (!(stream >> query_start.x >> query_start.y >> query_end.x >> query_end.y)) {
+            return JsonError(fields, "The request is neither a JSON object nor \\\"sx sy ex ey\\\"");
+        }
+    }
+    if (!grid.InBounds(query_start.x, query_start.y) || !grid.InBounds(query_end.x, query_end.y)) {
+        return JsonError(fields, "The start or the end is outside of the grid");
+    }
+
+    GridAnswer answer = AnswerGridQuery(worker.graph, worker.hierarchy, grid, options, query_start, query_end);
+    std::ostringstream response;
+    if (fields.count("id")) {
+        response << "{\"id\":" << fields["id"] << ",";
+    }
+    else {
+        response << "{";
+    }
+    response << "\"length\":" << answer.length << ",\"cost\":" << answer.cost << ",\"expansions\":" << answer.expansions << ",\"time_us\":" << answer.time;
+    if (fields["path"] == "true") {
+        response << ",\"path\":[";
+        for (size_t i = 0; i < answer.path.size(); i++) {
+            response << (i > 0 ? ",[" : "[") << answer.path[i].x << "," << answer.path[i].y << "]";
+        }
+        response << "]";
+    }
+    response << "}";
+    return response.str();
+}
+
+static int SolveGrid(const CliOptions& options) {
+    if (options.algorithm == CliAlgorithm::BellmanFord || options.algorithm == CliAlgorithm::SPFA || options.algorithm == CliAlgorithm::CH
+        || options.algorithm == CliAlgorithm::DeltaStepping || IsAllPairs(options.algorithm)) {
+        std::cerr << "Bellman-Ford, SPFA, the contraction hierarchy, delta-stepping and the all-pairs algorithms are only available for weighted graphs" << std::endl;
+        return 1;
+    }
+
+    Grid<CellState> grid;
+    sf::Vector2i start(-1, -1);
+    sf::Vector2i end(-1, -1);
+    bool moving_ai = options.grid_path.size() >= 4 && options.grid_path.compare(options.grid_path.size() - 4, 4, ".map") == 0;
+    if (!(moving_ai ? MapLoader::LoadMovingAIMap(options.grid_path, grid) : MapLoader::LoadGrid(options.grid_path, grid, start, end))) {
+        return 1;
+    }
+    if (options.start.x >= 0) start = options.start;
+    if (options.end.x >= 0) end = options.end;
+    if (start.x < 0) start = sf::Vector2i(0, 0);
+    if (end.x < 0) end = sf::Vector2i(grid.getWidth() - 1, grid.getHeight() - 1);
+
+    UnweightedGraph graph(grid, start, end);
+    graph.setConnectivity(options.connectivity, options.corner_cutting);
+    Landmarks landmarks;
+    if (!PrepareLandmarks(grid, options, landmarks)) {
+        return 1;
+    }
+    if (landmarks.getCount() > 0) {
+        if (!landmarks.Matches(grid)) {
+            std::cerr << "The landmarks were built for another map" << std::endl;
+            return 1;
+        }
+        graph.setLandmarks(&landmarks);
+    }
+    HierarchicalGraph hierarchy;
+    if (options.algorithm == CliAlgorithm::HPA) {
+        hierarchy.setObstacles(grid, options.cluster_size);
+    }
+    if (!options.serve_path.empty()) {
+        ThreadPool pool(options.threads);
+        std::vector<std::unique_ptr<GridWorker>> workers;
+        for (int worker = 0; worker < pool.getThreadCount(); worker++) {
+            workers.push_back(std::make_unique<GridWorker>(grid, start, end));
+            workers.back()->graph.setConnectivity(options.connectivity, options.corner_cutting);
+            if (landmarks.getCount() > 0) {
+                workers.back()->graph.setLandmarks(&landmarks);
+            }
+            if (options.algorithm == CliAlgorithm::HPA) {
+                workers.back()->hierarchy = hierarchy;
+            }
+        }
+        return Serve(options, pool, [&](const int& worker, const std::string& request) {
+            return AnswerGridRequest(*workers[worker], grid, options, start, end, request);
+        });
+    }
+    if (options.queries_path.empty()) {
+        RunGridQuery(graph, hierarchy, grid, options, start, end);
+        return 0;
+    }
+
+    std::ifstream queries(options.queries_path);
+    if (!queries) {
+        std::cerr << "Could not open the query file " << options.queries_path << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (std::getline(queries, line)) {
+        std::istringstream stream(line);
+        sf::Vector2i query_start, query_end;
+        if (stream >> query_start.x >> query_start.y >> query_end.x >> query_end.y) {
+            RunGridQuery(graph, hierarchy, grid, options, query_start, query_end);
+        }
+    }
+    return 0;
+}
+
+// Maps the hierarchy from the hierarchy file if it exists, otherwise contracts the graph and writes the file if one is given
+static bool PrepareHierarchy(const WeightedGraph& graph, const CliOptions& options, ContractionHierarchy& hierarchy) {
+    if (!options.hierarchy_path.empty() && std::ifstream(options.hierarchy_path)) {
+        if (!hierarchy.Load(options.hierarchy_path)) {
+            return false;
+        }
+        if (hierarchy.getVertexCount() != graph.getVertexCount()) {
+            std::cerr << "The hierarchy was built for another graph" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    if (!hierarchy.Build(graph)) {
+        return false;
+    }
+    std::cerr << "Contracted the graph with " << hierarchy.getShortcutCount() << " shortcuts in "
+        << ElapsedMicroseconds(begin) / 1000.0 << " ms" << std::endl;
+    return options.hierarchy_path.empty() || hierarchy.Save(options.hierarchy_path);
+}
+
+// The cost is summed from the cheapest edge between two consecutive vertices of the path
+static long long PathCost(const WeightedGraph& graph, const std::vector<int>& path) {
+    long long cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        cost += graph.getEdgeWeight(path[i - 1], path[i]);
+    }
+    return cost;
+}
+
+// The answer to a graph query, printed by the solver or sent back by the server
+struct GraphAnswer {
+    bool solved = true;
+    int target = -1;
+    long long cost = -1;
+    long long expansions = 0;
+    double time = 0;
+    std::vector<int> path;
+    std::vector<int> cycle;
+};
+
+// The hierarchy and the matrix are built once, a hierarchy query only runs the two upward searches and unpacks the shortcuts of
+// the path, a matrix query reads the distance and follows the next hops. The other algorithms search the graph they are given,
+// the costs are summed on the loaded graph
+static GraphAnswer AnswerGraphQuery(const WeightedGraph& graph, WeightedGraph& searched, ContractionHierarchy& hierarchy, const DistanceMatrix& matrix,
+    ThreadPool& pool, const CliOptions& options, const int& source, const int& target) {
+    GraphAnswer answer;
+    answer.target = target < 0 ? graph.getVertexCount() - 1 : target;
+    if (options.algorithm == CliAlgorithm::CH || IsAllPairs(options.algorithm)) {
+        auto begin = std::chrono::steady_clock::now();
+        answer.path = options.algorithm == CliAlgorithm::CH ? hierarchy.FindPath(source, answer.target) : matrix.FindPath(source, answer.target);
+        answer.time = ElapsedMicroseconds(begin);
+        if (!answer.path.empty()) {
+            answer.cost = options.algorithm == CliAlgorithm::CH ? PathCost(graph, answer.path) : matrix.getDistance(source, answer.target);
+        }
+        answer.expansions = options.algorithm == CliAlgorithm::CH ? hierarchy.getExpansions() : 0;
+        return answer;
+    }
+    searched.setSource(source);
+    searched.setDestination(target);
+
+    auto begin = std::chrono::steady_clock::now();
+    switch (options.algorithm) {
+    case CliAlgorithm::BFS:
+        searched.SetUpBFS();
+        break;
+    case CliAlgorithm::DFS:
+        searched.SetUpDFS();
+        break;
+    case CliAlgorithm::Dijkstra:
+        searched.SetUpDijkstra();
+        break;
+    case CliAlgorithm::BellmanFord:
+        searched.SetUpBellmanFord();
+        break;
+    case CliAlgorithm::SPFA:
+        searched.SetUpSPFA();
+        break;
+    case CliAlgorithm::AStar:
+        searched.SetUpAStar();
+        break;
+    case CliAlgorithm::DeltaStepping:
+        // Finds every distance at once, RunToCompletion has nothing left to do
+        if (!searched.RunDeltaStepping(pool, options.delta)) {
+            answer.solved = false;
+            return answer;
+        }
+        break;
+    default:
+        break;
+    }
+    searched.RunToCompletion();
+    answer.time = ElapsedMicroseconds(begin);
+    answer.target = searched.getDestination();
+    answer.expansions = searched.getExpansions();
+
+    // The distances are not shortest ones behind a negative cycle, the cycle is given instead of a path
+    answer.cycle = searched.getNegativeCycle();
+    if (answer.cycle.empty()) {
+        answer.path = searched.TracePath();
+    }
+    if (!answer.path.empty()) {
+        answer.cost = PathCost(graph, answer.path);
+    }
+    return answer;
+}
+
+static void RunGraphQuery(WeightedGraph& graph, ContractionHierarchy& hierarchy, const DistanceMatrix& matrix, ThreadPool& pool, const CliOptions& options,
+    const int& source, const int& target) {
+    if (source < 0 || source >= graph.getVertexCount() || target >= graph.getVertexCount()) {
+        std::cerr << "Query " << source << " -> " << target << " is outside of the graph" << std::endl;
+        return;
+    }
+    GraphAnswer answer = AnswerGraphQuery(graph, graph, hierarchy, matrix, pool, options, source, target);
+    if (!answer.solved) {
+        return;
+    }
+
+    std::cout << "algorithm=" << options.algorithm_name
+        << " source=" << source
+        << " target=" << answer.target
+        << " length=" << static_cast<int>(answer.path.size()) - 1
+        << " cost=" << answer.cost
+        << " expansions=" << answer.expansions
+        << " time_us=" << answer.time;
+    if (!answer.cycle.empty()) {
+        std::cout << " negative_cycle=";
+        for (size_t i = 0; i < answer.cycle.size(); i++) {
+            std::cout << (i > 0 ? "," : "") << answer.cycle[i];
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Search state of one worker of the server. The loaded graph, the landmarks and the matrix are only read by the workers, the
+// searches run on a copy of the graph and the hierarchy queries on a hierarchy sharing the edges of the one built at the start
+struct GraphWorker {
+    WeightedGraph graph;
+    ContractionHierarchy hierarchy;
+    ThreadPool pool; // Delta-stepping runs on the thread of the worker
+
+    GraphWorker() : pool(1) {}
+};
+
+// A request is {"id": ..., "source": s, "target": t, "path": true} or a line of a query file, the source and the target of
+// the options are taken when they are left out
+static std::string AnswerGraphRequest(GraphWorker& worker, const WeightedGraph& graph, const DistanceMatrix& matrix, const CliOptions& options,
+    const std::string& request) {
+    std::map<std::string, std::string> fields;
+    int source = options.source;
+    int target = options.target;
+    if (request[0] == '{') {
+        if (!ParseJsonObject(request, fields)) {
+            return JsonError(fields, "The request is not a JSON object");
+        }
+        if ((fields.count("source") && !ParseJsonInteger(fields["source"], source)) || (fields.count("target") && !ParseJsonInteger(fields["target"], target))) {
+            return JsonError(fields, "The source and the target are vertex numbers");
+        }
+    }
+    else {
+        std::istringstream stream(request);
+        if (!(stream >> source >> target)) {
+            return JsonError(fields, "The request is neither a JSON object nor \\\"source target\\\"");
+        }
+    }
+    if (source < 0 || source >= graph.getVertexCount() || target >= graph.getVertexCount()) {
+        return JsonError(fields, "The source or the target is outside of the graph");
+    }
+
+    GraphAnswer answer = AnswerGraphQuery(graph, worker.graph, worker.hierarchy, matrix, worker.pool, options, source, target);
+    if (!answer.solved) {
+        return JsonError(fields, "The search failed");
+    }
+    std::ostringstream response;
+    if (fields.count("id")) {
+        response << "{\"id\":" << fields["id"] << ",";
+    }
+    else {
+        response << "{";
+    }
+    response << "\"source\":" << source << ",\"target\":" << answer.target << ",\"length\":" << static_cast<int>(answer.path.size()) - 1
+        << ",\"cost\":" << answer.cost << ",\"expansions\":" << answer.expansions << ",\"time_us\":" << answer.time;
+    if (fields["path"] == "true") {
+        response << ",\"path\":[";
+        for (size_t i = 0; i < answer.path.size(); i++) {
+            response << (i > 0 ? "," : "") << answer.path[i];
+        }
+        response << "]";
+    }
+    if (!answer.cycle.empty()) {
+        response << ",\"negative_cycle\":[";
+        for (size_t i = 0; i < answer.cycle.size(); i++) {
+            response << (i > 0 ? "," : "") << answer.cycle[i];
+        }
+        response << "]";
+    }
+    response << "}";
+    return response.str();
+}
+
+static int SolveGraph(const CliOptions& options) {
+    if (options.algorithm == CliAlgorithm::GBFS
+        || options.algorithm == CliAlgorithm::JPS || options.algorithm == CliAlgorithm::JPSPlus
+        || options.algorithm == CliAlgorithm::BitboardBFS || options.algorithm == CliAlgorithm::BidirectionalBFS
+        || options.algorithm == CliAlgorithm::BidirectionalDijkstra || options.algorithm == CliAlgorithm::BidirectionalAStar) {
+        std::cerr << "GBFS, JPS, the bitboard BFS and the bidirectional searches are only available for grids" << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(options.threads);
+    WeightedGraph graph;
+    auto load_begin = std::chrono::steady_clock::now();
+    bool dimacs = options.graph_path.size() >= 3 && options.graph_path.compare(options.graph_path.size() - 3, 3, ".gr") == 0;
+    if (!(dimacs ? MapLoader::LoadDimacs(options.graph_path, graph, pool) : MapLoader::LoadEdgeList(options.graph_path, graph, pool))) {
+        return 1;
+    }
+    std::cerr << "Loaded " << graph.getVertexCount() << " vertices and " << graph.getEdgeCount() << " edges on " << pool.getThreadCount()
+        << " threads in " << ElapsedMicroseconds(load_begin) / 1000.0 << " ms" << std::endl;
+    if (graph.getVertexCount() == 0) {
+        std::cerr << "The graph is empty" << std::endl;
+        return 1;
+    }
+    Landmarks landmarks;
+    if (!PrepareLandmarks(graph, options, landmarks)) {
+        return 1;
+    }
+    if (landmarks.getCount() > 0) {
+        if (!landmarks.Matches(graph)) {
+            std::cerr << "The landmarks were built for another graph" << std::endl;
+            return 1;
+        }
+        graph.setLandmarks(&landmarks);
+    }
+    ContractionHierarchy hierarchy;
+    if (options.algorithm == CliAlgorithm::CH && !PrepareHierarchy(graph, options, hierarchy)) {
+        return 1;
+    }
+    if (options.algorithm == CliAlgorithm::DeltaStepping) {
+        std::cerr << "Delta-stepping on " << pool.getThreadCount() << " threads with buckets of width "
+            << (options.delta > 0 ? options.delta : graph.SuggestDelta()) << std::endl;
+    }
+    DistanceMatrix matrix;
+    if (IsAllPairs(options.algorithm)) {
+        auto begin = std::chrono::steady_clock::now();
+        bool built = options.algorithm == CliAlgorithm::Johnson ? matrix.BuildJohnson(graph, pool)
+            : options.algorithm == CliAlgorithm::FloydWarshall ? matrix.BuildFloydWarshall(graph, pool)
+            : matrix.Build(graph, pool, options.floyd_warshall_limit);
+        if (!built) {
+            return 1;
+        }
+        std::cerr << "Built the distance matrix on " << pool.getThreadCount() << " threads in " << ElapsedMicroseconds(begin) / 1000.0 << " ms" << std::endl;
+    }
+    if (!options.serve_path.empty()) {
+        std::vector<std::unique_ptr<GraphWorker>> workers;
+        for (int worker = 0; worker < pool.getThreadCount(); worker++) {
+            workers.push_back(std::make_unique<GraphWorker>());
+            if (options.algorithm == CliAlgorithm::CH) {
+                workers.back()->hierarchy.Share(hierarchy);
+            }
+            else if (!IsAllPairs(options.algorithm)) {
+                workers.back()->graph = graph;
+            }
+        }
+        return Serve(options, pool, [&](const int& worker, const std::string& request) {
+            return AnswerGraphRequest(*workers[worker], graph, matrix, options, request);
+        });
+    }
+
+    if (options.queries_path.empty()) {
+        RunGraphQuery(graph, hierarchy, matrix, pool, options, options.source, options.target);
+        return 0;
+    }
+
+    std::ifstream queries(options.queries_path);
+    if (!queries) {
+        std::cerr << "Could not open the query file " << options.queries_path << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (std::getline(queries, line)) {
+        std::istringstream stream(line);
+        int source, target;
+        if (stream >> source >> target) {
+            RunGraphQuery(graph, hierarchy, matrix, pool, options, source, target);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    CliOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (!options.grid_path.empty()) {
+        return SolveGrid(options);
+    }
+    return SolveGraph(options);
+}
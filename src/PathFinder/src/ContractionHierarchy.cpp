@@ -0,0 +1,570 @@
+#include "../headers/ContractionHierarchy.hpp"
+#include "../headers/WeightedGraph.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+#define CH_FILE_VERSION 1
+#define WITNESS_SETTLE_LIMIT 500 // Vertices a witness search may settle before it gives up and the shortcut is added
+
+static const char hierarchy_file_magic[8] = { 'P', 'F', 'C', 'H', 'I', 'E', 'R', 'A' };
+
+/// \brief The header of a hierarchy file, followed by the forward offsets and edges and the backward offsets and edges.
+struct HierarchyFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t vertex_count;
+	uint64_t forward_count;
+	uint64_t backward_count;
+	uint64_t shortcut_count;
+};
+
+typedef std::pair<uint32_t, uint32_t> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> MinQueue;
+
+/// \class Contractor
+/// \brief The graph while its vertices are contracted, the edges between the remaining vertices in both directions.
+class Contractor {
+public:
+	explicit Contractor(const uint32_t& vertex_count)
+		: out(vertex_count), in(vertex_count), contracted_neighbours(vertex_count, 0), shortcuts(0),
+		witness_distances(vertex_count, CH_UNREACHED), witness_targets(vertex_count, 0) {}
+
+	/// \brief Add an edge, or lower the weight of the edge between the same vertices.
+	void AddEdge(const uint32_t& from, const uint32_t& to, const uint32_t& weight, const uint32_t& middle) {
+		for (HierarchyEdge& edge : out[from]) {
+			if (edge.vertex == to) {
+				if (weight < edge.weight) {
+					edge.weight = weight;
+					edge.middle = middle;
+					for (HierarchyEdge& reverse : in[to]) {
+						if (reverse.vertex == from) {
+							reverse.weight = weight;
+							reverse.middle = middle;
+						}
+					}
+				}
+				return;
+			}
+		}
+		out[from].push_back({ to, weight, middle });
+		in[to].push_back({ from, weight, middle });
+	}
+
+	/// \brief Count the shortcuts contracting a vertex needs, they are also added when the contraction is not simulated.
+	int Contract(const uint32_t& vertex, const bool& simulate) {
+		int count = 0;
+		added.clear();
+		for (const HierarchyEdge& incoming : in[vertex]) {
+			uint32_t limit = 0;
+			int targets = 0;
+			for (const HierarchyEdge& outgoing : out[vertex]) {
+				if (outgoing.vertex != incoming.vertex) {
+					limit = std::max(limit, incoming.weight + outgoing.weight);
+					witness_targets[outgoing.vertex] = 1;
+					targets++;
+				}
+			}
+			if (targets == 0) {
+				continue;
+			}
+			WitnessSearch(incoming.vertex, vertex, limit, targets);
+			for (const HierarchyEdge& outgoing : out[vertex]) {
+				witness_targets[outgoing.vertex] = 0;
+				if (outgoing.vertex == incoming.vertex) {
+					continue;
+				}
+				uint32_t through = incoming.weight + outgoing.weight;
+				if (witness_distances[outgoing.vertex] > through) {
+					count++;
+					if (!simulate) {
+						added.push_back({ incoming.vertex, { outgoing.vertex, through, vertex } });
+					}
+				}
+			}
+		}
+		// The shortcuts are added after the searches, so no search sees a shortcut over the contracted vertex
+		for (const auto& shortcut : added) {
+			AddEdge(shortcut.first, shortcut.second.vertex, shortcut.second.weight, shortcut.second.middle);
+			shortcuts++;
+		}
+		return count;
+	}
+
+	/// \brief The priority of a vertex, the lower ones are contracted first.
+	/// \details Twice the edge difference, the contracted neighbours spread the contractions over the graph.
+	int Priority(const uint32_t& vertex) {
+		int removed = static_cast<int>(out[vertex].size() + in[vertex].size());
+		return 2 * (Contract(vertex, true) - removed) + contracted_neighbours[vertex];
+	}
+
+	/// \brief Remove a contracted vertex from the remaining graph, its edges all lead to later contracted vertices.
+	/// \param upward_out Receives the edges leaving the vertex.
+	/// \param upward_in Receives the edges entering the vertex.
+	void Remove(const uint32_t& vertex, std::vector<HierarchyEdge>& upward_out, std::vector<HierarchyEdge>& upward_in) {
+		for (const HierarchyEdge& edge : out[vertex]) {
+			EraseEdge(in[edge.vertex], vertex);
+			contracted_neighbours[edge.vertex]++;
+		}
+		for (const HierarchyEdge& edge : in[vertex]) {
+			EraseEdge(out[edge.vertex], vertex);
+			contracted_neighbours[edge.vertex]++;
+		}
+		upward_out.swap(out[vertex]);
+		upward_in.swap(in[vertex]);
+		std::vector<HierarchyEdge>().swap(out[vertex]);
+		std::vector<HierarchyEdge>().swap(in[vertex]);
+	}
+
+	std::vector<std::vector<HierarchyEdge>> out;      ///< Edges leaving every remaining vertex.
+	std::vector<std::vector<HierarchyEdge>> in;       ///< Edges entering every remaining vertex, the vertex of an edge is where it starts.
+	std::vector<int> contracted_neighbours;           ///< Number of contracted neighbours of every vertex.
+	size_t shortcuts;                                 ///< Number of shortcuts added.
+
+private:
+	/// \brief Remove the edge to a vertex from a list, the order of the list is not kept.
+	static void EraseEdge(std::vector<HierarchyEdge>& edges, const uint32_t& vertex) {
+		for (size_t i = 0; i < edges.size(); i++) {
+			if (edges[i].vertex == vertex) {
+				edges[i] = edges.back();
+				edges.pop_back();
+				return;
+			}
+		}
+	}
+
+	/// \brief Dijkstra's algorithm from a vertex over the remaining vertices without the contracted one.
+	/// \details The search stops once it settled every target, passed the longest path through the contracted vertex or
+	/// settled WITNESS_SETTLE_LIMIT vertices, a target it did not reach gets a shortcut.
+	void WitnessSearch(const uint32_t& source, const uint32_t& avoided, const uint32_t& limit, int targets) {
+		for (uint32_t vertex : witness_touched) {
+			witness_distances[vertex] = CH_UNREACHED;
+		}
+		witness_touched.clear();
+		witness_queue.clear();
+		witness_distances[source] = 0;
+		witness_touched.push_back(source);
+		witness_queue.push_back({ 0, source });
+		int settled = 0;
+		while (!witness_queue.empty() && settled < WITNESS_SETTLE_LIMIT && targets > 0) {
+			std::pop_heap(witness_queue.begin(), witness_queue.end(), std::greater<QueueEntry>());
+			uint32_t distance = witness_queue.back().first;
+			uint32_t vertex = witness_queue.back().second;
+			witness_queue.pop_back();
+			if (distance > witness_distances[vertex]) {
+				continue;
+			}
+			if (distance > limit) {
+				break;
+			}
+			settled++;
+			targets -= witness_targets[vertex];
+			for (const HierarchyEdge& edge : out[vertex]) {
+				if (edge.vertex == avoided) {
+					continue;
+				}
+				uint32_t next_distance = distance + edge.weight;
+				if (next_distance < witness_distances[edge.vertex]) {
+					if (witness_distances[edge.vertex] == CH_UNREACHED) {
+						witness_touched.push_back(edge.vertex);
+					}
+					witness_distances[edge.vertex] = next_distance;
+					witness_queue.push_back({ next_distance, edge.vertex });
+					std::push_heap(witness_queue.begin(), witness_queue.end(), std::greater<QueueEntry>());
+				}
+			}
+		}
+	}
+
+	std::vector<uint32_t> witness_distances;          ///< Distances of the last witness search.
+	std::vector<uint32_t> witness_touched;            ///< Vertices reached by the last witness search.
+	std::vector<QueueEntry> witness_queue;            ///< Heap of the witness searches, kept to reuse its memory.
+	std::vector<unsigned char> witness_targets;       ///< Flag of the out-neighbours of the contracted vertex.
+	std::vector<std::pair<uint32_t, HierarchyEdge>> added;  ///< Shortcuts of the contraction, with the vertex they start at.
+};
+
+ContractionHierarchy::ContractionHierarchy()
+	: vertex_count(0), forward_count(0), backward_count(0), shortcut_count(0), forward_begin(nullptr), forward_edges(nullptr),
+	backward_begin(nullptr), backward_edges(nullptr), meeting(CH_UNREACHED), expansions(0) {}
+
+bool ContractionHierarchy::Build(const WeightedGraph& graph) {
+	Clear();
+	if (graph.getVertexCount() == 0) {
+		std::cerr << "The graph is empty" << std::endl;
+		return false;
+	}
+	uint32_t vertices = static_cast<uint32_t>(graph.getVertexCount());
+	Contractor contractor(vertices);
+	bool negative = false;
+	graph.ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		negative = negative || weight < 0;
+		if (weight >= 0 && from >= 0 && from < static_cast<int>(vertices) && to >= 0 && to < static_cast<int>(vertices) && from != to) {
+			contractor.AddEdge(from, to, weight, CH_UNREACHED);
+		}
+	});
+	if (negative) {
+		std::cerr << "Contraction Hierarchies need non-negative edge weights" << std::endl;
+		return false;
+	}
+
+	// Lazy updates: the priority of the popped vertex is computed again, it is contracted only if it is still the smallest
+	std::priority_queue<std::pair<int, uint32_t>, std::vector<std::pair<int, uint32_t>>, std::greater<std::pair<int, uint32_t>>> order;
+	std::vector<int> priorities(vertices);
+	for (uint32_t v = 0; v < vertices; v++) {
+		priorities[v] = contractor.Priority(v);
+		order.push({ priorities[v], v });
+	}
+	std::vector<std::vector<HierarchyEdge>> upward_out(vertices), upward_in(vertices);
+	std::vector<unsigned char> contracted(vertices, 0);
+	while (!order.empty()) {
+		uint32_t vertex = order.top().second;
+		int queued = order.top().first;
+		order.pop();
+		if (contracted[vertex] || queued != priorities[vertex]) {
+			continue;
+		}
+		priorities[vertex] = contractor.Priority(vertex);
+		if (!order.empty() && priorities[vertex] > order.top().first) {
+			order.push({ priorities[vertex], vertex });
+			continue;
+		}
+		contractor.Contract(vertex, false);
+		contractor.Remove(vertex, upward_out[vertex], upward_in[vertex]);
+		contracted[vertex] = 1;
+	}
+
+	// The edges a vertex had when it was contracted lead to later contracted vertices, only these are searched by the queries
+	vertex_count = vertices;
+	owned_begins.assign(2 * (static_cast<size_t>(vertices) + 1), 0);
+	for (uint32_t v = 0; v < vertices; v++) {
+		owned_begins[v + 1] = owned_begins[v] + static_cast<uint32_t>(upward_out[v].size());
+		owned_begins[vertices + 1 + v + 1] = owned_begins[vertices + 1 + v] + static_cast<uint32_t>(upward_in[v].size());
+	}
+	forward_count = owned_begins[vertices];
+	backward_count = owned_begins[2 * static_cast<size_t>(vertices) + 1];
+	owned_edges.clear();
+	owned_edges.reserve(forward_count + backward_count);
+	for (uint32_t v = 0; v < vertices; v++) {
+		owned_edges.insert(owned_edges.end(), upward_out[v].begin(), upward_out[v].end());
+	}
+	for (uint32_t v = 0; v < vertices; v++) {
+		owned_edges.insert(owned_edges.end(), upward_in[v].begin(), upward_in[v].end());
+	}
+	shortcut_count = contractor.shortcuts;
+	AttachStorage();
+	PrepareQueries();
+	return true;
+}
+
+void ContractionHierarchy::AttachStorage() {
+	forward_begin = owned_begins.data();
+	backward_begin = owned_begins.data() + vertex_count + 1;
+	forward_edges = owned_edges.data();
+	backward_edges = owned_edges.data() + forward_count;
+}
+
+void ContractionHierarchy::PrepareQueries() {
+	forward_distances.assign(vertex_count, CH_UNREACHED);
+	backward_distances.assign(vertex_count, CH_UNREACHED);
+	forward_parents.assign(vertex_count, CH_UNREACHED);
+	backward_parents.assign(vertex_count, CH_UNREACHED);
+	touched.clear();
+}
+
+bool ContractionHierarchy::Save(const std::string& path) const {
+	std::ofstream output(path, std::ios::binary);
+	if (!output) {
+		std::cerr << "Could not write the hierarchy file " << path << std::endl;
+		return false;
+	}
+	HierarchyFileHeader header;
+	std::memcpy(header.magic, hierarchy_file_magic, sizeof(header.magic));
+	header.version = CH_FILE_VERSION;
+	header.vertex_count = vertex_count;
+	header.forward_count = forward_count;
+	header.backward_count = backward_count;
+	header.shortcut_count = shortcut_count;
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(forward_begin), (static_cast<size_t>(vertex_count) + 1) * sizeof(uint32_t));
+	output.write(reinterpret_cast<const char*>(backward_begin), (static_cast<size_t>(vertex_count) + 1) * sizeof(uint32_t));
+	output.write(reinterpret_cast<const char*>(forward_edges), forward_count * sizeof(HierarchyEdge));
+	output.write(reinterpret_cast<const char*>(backward_edges), backward_count * sizeof(HierarchyEdge));
+	if (!output) {
+		std::cerr << "Could not write the hierarchy file " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Checks that the rows of a mapped file index only its edges and that the edges lead to its vertices, the queries trust both
+static bool ValidRows(const uint32_t* begin, const HierarchyEdge* edges, const uint32_t& vertex_count, const uint64_t& edge_count) {
+	if (begin[0] != 0 || begin[vertex_count] != edge_count) {
+		return false;
+	}
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		if (begin[v] > begin[v + 1]) {
+			return false;
+		}
+	}
+	for (uint64_t e = 0; e < edge_count; e++) {
+		if (edges[e].vertex >= vertex_count || (edges[e].middle >= vertex_count && edges[e].middle != CH_UNREACHED)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ContractionHierarchy::Load(const std::string& path) {
+	Clear();
+	if (!file.Open(path)) {
+		return false;
+	}
+	HierarchyFileHeader header;
+	if (file.getSize() < sizeof(header)) {
+		std::cerr << "The hierarchy file " << path << " is too short" << std::endl;
+		Clear();
+		return false;
+	}
+	std::memcpy(&header, file.getData(), sizeof(header));
+	if (std::memcmp(header.magic, hierarchy_file_magic, sizeof(header.magic)) != 0 || header.version != CH_FILE_VERSION) {
+		std::cerr << "The file " << path << " is not a hierarchy file of this version" << std::endl;
+		Clear();
+		return false;
+	}
+	size_t begins_size = (static_cast<size_t>(header.vertex_count) + 1) * sizeof(uint32_t);
+	size_t most_edges = file.getSize() / sizeof(HierarchyEdge);
+	if (header.forward_count > most_edges || header.backward_count > most_edges) { // The expected size would overflow
+		std::cerr << "The hierarchy file " << path << " has " << file.getSize() << " bytes, too few for its edge counts" << std::endl;
+		Clear();
+		return false;
+	}
+	size_t expected = sizeof(header) + 2 * begins_size + (header.forward_count + header.backward_count) * sizeof(HierarchyEdge);
+	if (file.getSize() != expected) {
+		std::cerr << "The hierarchy file " << path << " has " << file.getSize() << " bytes, expected " << expected << std::endl;
+		Clear();
+		return false;
+	}
+
+	vertex_count = header.vertex_count;
+	forward_count = header.forward_count;
+	backward_count = header.backward_count;
+	shortcut_count = header.shortcut_count;
+	const char* data = file.getData() + sizeof(header);
+	forward_begin = reinterpret_cast<const uint32_t*>(data);
+	backward_begin = reinterpret_cast<const uint32_t*>(data + begins_size);
+	forward_edges = reinterpret_cast<const HierarchyEdge*>(data + 2 * begins_size);
+	backward_edges = forward_edges + forward_count;
+	if (!ValidRows(forward_begin, forward_edges, vertex_count, forward_count) || !ValidRows(backward_begin, backward_edges, vertex_count, backward_count)) {
+		std::cerr << "The hierarchy file " << path << " is corrupted, its edges do not fit its vertices" << std::endl;
+		Clear();
+		return false;
+	}
+	PrepareQueries();
+	return true;
+}
+
+void ContractionHierarchy::Share(const ContractionHierarchy& hierarchy) {
+	Clear();
+	vertex_count = hierarchy.vertex_count;
+	forward_count = hierarchy.forward_count;
+	backward_count = hierarchy.backward_count;
+	shortcut_count = hierarchy.shortcut_count;
+	forward_begin = hierarchy.forward_begin;
+	forward_edges = hierarchy.forward_edges;
+	backward_begin = hierarchy.backward_begin;
+	backward_edges = hierarchy.backward_edges;
+	PrepareQueries();
+}
+
+void ContractionHierarchy::Clear() {
+	file.Close();
+	owned_begins.clear();
+	owned_edges.clear();
+	vertex_count = 0;
+	forward_count = 0;
+	backward_count = 0;
+	shortcut_count = 0;
+	forward_begin = nullptr;
+	forward_edges = nullptr;
+	backward_begin = nullptr;
+	backward_edges = nullptr;
+	PrepareQueries();
+}
+
+uint32_t ContractionHierarchy::Search(const uint32_t& source, const uint32_t& target) {
+	for (uint32_t vertex : touched) {
+		forward_distances[vertex] = CH_UNREACHED;
+		backward_distances[vertex] = CH_UNREACHED;
+	}
+	touched.clear();
+	expansions = 0;
+	meeting = CH_UNREACHED;
+
+	MinQueue forward_queue, backward_queue;
+	forward_distances[source] = 0;
+	forward_parents[source] = CH_UNREACHED;
+	backward_distances[target] = 0;
+	backward_parents[target] = CH_UNREACHED;
+	touched.push_back(source);
+	touched.push_back(target);
+	forward_queue.push({ 0, source });
+	backward_queue.push({ 0, target });
+
+	uint32_t best = CH_UNREACHED;
+	while (true) {
+		// A side is done once its smallest distance reaches the best path, the side with the smaller distance goes next
+		bool forward_open = !forward_queue.empty() && forward_queue.top().first < best;
+		bool backward_open = !backward_queue.empty() && backward_queue.top().first < best;
+		if (!forward_open && !backward_open) {
+			break;
+		}
+		bool forward = forward_open && (!backward_open || forward_queue.top().first <= backward_queue.top().first);
+		MinQueue& queue = forward ? forward_queue : backward_queue;
+		std::vector<uint32_t>& own_distances = forward ? forward_distances : backward_distances;
+		std::vector<uint32_t>& own_parents = forward ? forward_parents : backward_parents;
+		const std::vector<uint32_t>& other_distances = forward ? backward_distances : forward_distances;
+		const uint32_t* own_begin = forward ? forward_begin : backward_begin;
+		const HierarchyEdge* own_edges = forward ? forward_edges : backward_edges;
+		const uint32_t* opposite_begin = forward ? backward_begin : forward_begin;
+		const HierarchyEdge* opposite_edges = forward ? backward_edges : forward_edges;
+
+		uint32_t distance = queue.top().first;
+		uint32_t vertex = queue.top().second;
+		queue.pop();
+		if (distance > own_distances[vertex]) {
+			continue;
+		}
+		expansions++;
+		if (other_distances[vertex] != CH_UNREACHED && distance + other_distances[vertex] < best) {
+			best = distance + other_distances[vertex];
+			meeting = vertex;
+		}
+
+		// Stall on demand: a higher vertex which reaches this one on a shorter path means it is not on a shortest upward path
+		bool stalled = false;
+		for (uint32_t i = opposite_begin[vertex]; i < opposite_begin[vertex + 1]; i++) {
+			const HierarchyEdge& edge = opposite_edges[i];
+			if (own_distances[edge.vertex] != CH_UNREACHED && own_distances[edge.vertex] + edge.weight < distance) {
+				stalled = true;
+				break;
+			}
+		}
+		if (stalled) {
+			continue;
+		}
+
+		for (uint32_t i = own_begin[vertex]; i < own_begin[vertex + 1]; i++) {
+			const HierarchyEdge& edge = own_edges[i];
+			uint32_t next_distance = distance + edge.weight;
+			if (next_distance < own_distances[edge.vertex]) {
+				if (forward_distances[edge.vertex] == CH_UNREACHED && backward_distances[edge.vertex] == CH_UNREACHED) {
+					touched.push_back(edge.vertex);
+				}
+				own_distances[edge.vertex] = next_distance;
+				own_parents[edge.vertex] = vertex;
+				queue.push({ next_distance, edge.vertex });
+			}
+		}
+	}
+	return best;
+}
+
+long long ContractionHierarchy::Query(const int& source, const int& target) {
+	if (source < 0 || target < 0 || source >= static_cast<int>(vertex_count) || target >= static_cast<int>(vertex_count)) {
+		return -1;
+	}
+	uint32_t distance = Search(source, target);
+	return distance == CH_UNREACHED ? -1 : static_cast<long long>(distance);
+}
+
+const HierarchyEdge* ContractionHierarchy::FindEdge(const uint32_t* begin, const HierarchyEdge* edges, const uint32_t& lower,
+	const uint32_t& upper, const uint32_t& weight) const {
+	const HierarchyEdge* found = nullptr;
+	for (uint32_t i = begin[lower]; i < begin[lower + 1]; i++) {
+		if (edges[i].vertex == upper && (found == nullptr || edges[i].weight == weight)) {
+			found = &edges[i];
+		}
+	}
+	return found;
+}
+
+void ContractionHierarchy::UnpackEdge(const uint32_t& from, const uint32_t& to, const uint32_t& middle, std::vector<int>& path) const {
+	if (middle == CH_UNREACHED) {
+		path.push_back(static_cast<int>(to));
+		return;
+	}
+	// The middle was contracted before both ends, so its edges to them are upward edges of the middle
+	uint32_t first_middle = CH_UNREACHED;
+	for (uint32_t i = backward_begin[middle]; i < backward_begin[middle + 1]; i++) {
+		if (backward_edges[i].vertex == from) {
+			first_middle = backward_edges[i].middle;
+			break;
+		}
+	}
+	uint32_t second_middle = CH_UNREACHED;
+	for (uint32_t i = forward_begin[middle]; i < forward_begin[middle + 1]; i++) {
+		if (forward_edges[i].vertex == to) {
+			second_middle = forward_edges[i].middle;
+			break;
+		}
+	}
+	UnpackEdge(from, middle, first_middle, path);
+	UnpackEdge(middle, to, second_middle, path);
+}
+
+std::vector<int> ContractionHierarchy::FindPath(const int& source, const int& target) {
+	std::vector<int> path;
+	if (Query(source, target) < 0) {
+		return path;
+	}
+
+	// Every hop is an upward edge of its lower end, the forward ones go up to the meeting vertex and the backward ones down from it
+	std::vector<const HierarchyEdge*> hops;
+	std::vector<uint32_t> lower_ends;
+	for (uint32_t vertex = meeting; vertex != static_cast<uint32_t>(source); vertex = forward_parents[vertex]) {
+		lower_ends.push_back(forward_parents[vertex]);
+		hops.push_back(FindEdge(forward_begin, forward_edges, forward_parents[vertex], vertex,
+			forward_distances[vertex] - forward_distances[forward_parents[vertex]]));
+	}
+	std::reverse(hops.begin(), hops.end());
+	std::reverse(lower_ends.begin(), lower_ends.end());
+	size_t upward_hops = hops.size();
+	for (uint32_t vertex = meeting; vertex != static_cast<uint32_t>(target); vertex = backward_parents[vertex]) {
+		lower_ends.push_back(backward_parents[vertex]);
+		hops.push_back(FindEdge(backward_begin, backward_edges, backward_parents[vertex], vertex,
+			backward_distances[vertex] - backward_distances[backward_parents[vertex]]));
+	}
+
+	path.push_back(source);
+	for (size_t i = 0; i < hops.size(); i++) {
+		uint32_t from = i < upward_hops ? lower_ends[i] : hops[i]->vertex;
+		uint32_t to = i < upward_hops ? hops[i]->vertex : lower_ends[i];
+		UnpackEdge(from, to, hops[i]->middle, path);
+	}
+	return path;
+}
+
+int ContractionHierarchy::getVertexCount() const {
+	return static_cast<int>(vertex_count);
+}
+
+size_t ContractionHierarchy::getEdgeCount() const {
+	return forward_count + backward_count;
+}
+
+size_t ContractionHierarchy::getShortcutCount() const {
+	return shortcut_count;
+}
+
+long long ContractionHierarchy::getExpansions() const {
+	return expansions;
+}
+
+size_t ContractionHierarchy::getMemoryUsage() const {
+	return 2 * (static_cast<size_t>(vertex_count) + 1) * sizeof(uint32_t) + (forward_count + backward_count) * sizeof(HierarchyEdge)
+		+ 4 * static_cast<size_t>(vertex_count) * sizeof(uint32_t);
+}
@@ -0,0 +1,347 @@
+#include "../headers/DistanceMatrix.hpp"
+#include "../headers/WeightedGraph.hpp"
+#include "../headers/ThreadPool.hpp"
+
+#include <iostream>
+#include <climits>
+#include <queue>
+#include <atomic>
+#include <new>
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#define FLOYD_WARSHALL_INFINITY (INT_MAX / 2) // Unreached pairs during Floyd-Warshall, the distances are kept within plus and minus this
+// value, so two of them can be added without overflow even when a negative cycle keeps lowering them
+
+/// \brief Orders the queue of the searches by the reweighted distance only, the vertex is not compared.
+struct ReducedComparator {
+	bool operator()(const std::pair<long long, int>& a, const std::pair<long long, int>& b) const {
+		return a.first > b.first;
+	}
+};
+
+DistanceMatrix::DistanceMatrix() : vertex_count(0), stride(0) {}
+
+void DistanceMatrix::Clear() {
+	vertex_count = 0;
+	stride = 0;
+	std::vector<int>().swap(distances);
+	std::vector<int>().swap(next_hops);
+}
+
+bool DistanceMatrix::Allocate(const int& vertices, const int& unreached) {
+	Clear();
+	int padded = (vertices + MATRIX_ROW_ALIGNMENT - 1) / MATRIX_ROW_ALIGNMENT * MATRIX_ROW_ALIGNMENT;
+	try {
+		distances.assign(static_cast<size_t>(vertices) * padded, unreached);
+		next_hops.assign(static_cast<size_t>(vertices) * padded, -1);
+	}
+	catch (const std::bad_alloc&) {
+		Clear();
+		std::cerr << "The distance matrix of " << vertices << " vertices does not fit in memory" << std::endl;
+		return false;
+	}
+	vertex_count = vertices;
+	stride = padded;
+	return true;
+}
+
+bool DistanceMatrix::Build(const WeightedGraph& graph, ThreadPool& pool, const int& floyd_warshall_limit) {
+	long long vertices = graph.getVertexCount();
+	if (vertices <= floyd_warshall_limit && static_cast<long long>(graph.getEdgeCount()) * FLOYD_WARSHALL_DENSITY >= vertices * vertices) {
+		return BuildFloydWarshall(graph, pool);
+	}
+	return BuildJohnson(graph, pool);
+}
+
+// Relaxes the rows of a block through the middle vertices of another, a row i is lowered by row k plus the distance from i to k.
+// The columns are taken eight (AVX2) or four (SSE4.1) at a time, a lowered distance takes the next hop from i to k.
+static void RelaxBlock(int* distances, int* hops, const size_t& stride, const int& i_begin, const int& i_end, const int& j_begin,
+	const int& j_end, const int& k_begin, const int& k_end) {
+	for (int k = k_begin; k < k_end; k++) {
+		const int* row_k = distances + k * stride;
+		for (int i = i_begin; i < i_end; i++) {
+			int* row_i = distances + i * stride;
+			int* hops_i = hops + i * stride;
+			int to_middle = row_i[k];
+			if (to_middle >= FLOYD_WARSHALL_INFINITY) {
+				continue;
+			}
+			int hop = hops_i[k];
+			int j = j_begin;
+#if defined(__AVX2__)
+			const __m256i wide_middle = _mm256_set1_epi32(to_middle);
+			const __m256i wide_hop = _mm256_set1_epi32(hop);
+			const __m256i wide_infinity = _mm256_set1_epi32(FLOYD_WARSHALL_INFINITY);
+			const __m256i wide_floor = _mm256_set1_epi32(-FLOYD_WARSHALL_INFINITY);
+			for (; j + 8 <= j_end; j += 8) {
+				__m256i from_middle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_k + j));
+				__m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_i + j));
+				__m256i through = _mm256_max_epi32(_mm256_add_epi32(wide_middle, from_middle), wide_floor);
+				// An unreached entry of row k plus a negative distance to k must not look reached
+				__m256i lower = _mm256_and_si256(_mm256_cmpgt_epi32(current, through), _mm256_cmpgt_epi32(wide_infinity, from_middle));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(row_i + j), _mm256_blendv_epi8(current, through, lower));
+				__m256i current_hops = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hops_i + j));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(hops_i + j), _mm256_blendv_epi8(current_hops, wide_hop, lower));
+			}
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+			const __m128i narrow_middle = _mm_set1_epi32(to_middle);
+			const __m128i narrow_hop = _mm_set1_epi32(hop);
+			const __m128i narrow_infinity = _mm_set1_epi32(FLOYD_WARSHALL_INFINITY);
+			const __m128i narrow_floor = _mm_set1_epi32(-FLOYD_WARSHALL_INFINITY);
+			for (; j + 4 <= j_end; j += 4) {
+				__m128i from_middle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_k + j));
+				__m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_i + j));
+				__m128i through = _mm_max_epi32(_mm_add_epi32(narrow_middle, from_middle), narrow_floor);
+				__m128i lower = _mm_and_si128(_mm_cmpgt_epi32(current, through), _mm_cmpgt_epi32(narrow_infinity, from_middle));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(row_i + j), _mm_blendv_epi8(current, through, lower));
+				__m128i current_hops = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hops_i + j));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(hops_i + j), _mm_blendv_epi8(current_hops, narrow_hop, lower));
+			}
+#endif
+			for (; j < j_end; j++) {
+				int through = std::max(to_middle + row_k[j], -FLOYD_WARSHALL_INFINITY);
+				if (row_k[j] < FLOYD_WARSHALL_INFINITY && through < row_i[j]) {
+					row_i[j] = through;
+					hops_i[j] = hop;
+				}
+			}
+		}
+	}
+}
+
+bool DistanceMatrix::BuildFloydWarshall(const WeightedGraph& graph, ThreadPool& pool) {
+	Clear();
+	int vertices = graph.getVertexCount();
+	if (vertices == 0) {
+		std::cerr << "The graph is empty" << std::endl;
+		return false;
+	}
+	if (!Allocate(vertices, FLOYD_WARSHALL_INFINITY)) {
+		return false;
+	}
+	for (int v = 0; v < vertices; v++) {
+		distances[static_cast<size_t>(v) * stride + v] = 0;
+		next_hops[static_cast<size_t>(v) * stride + v] = v;
+	}
+	graph.ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		size_t index = static_cast<size_t>(from) * stride + to;
+		if (from >= 0 && from < vertices && to >= 0 && to < vertices && weight < distances[index]) {
+			distances[index] = std::max(weight, -FLOYD_WARSHALL_INFINITY);
+			next_hops[index] = to;
+		}
+	});
+
+	// The rows end at the vertex count and the columns at the padded stride, the padding columns stay unreached
+	int* matrix = distances.data();
+	int* hops = next_hops.data();
+	size_t row_length = static_cast<size_t>(stride);
+	int blocks = (vertices + FLOYD_WARSHALL_BLOCK - 1) / FLOYD_WARSHALL_BLOCK;
+	int threads = pool.getThreadCount();
+	auto rows = [&](const int& block, int& begin, int& end) {
+		begin = block * FLOYD_WARSHALL_BLOCK;
+		end = std::min(begin + FLOYD_WARSHALL_BLOCK, vertices);
+	};
+	auto columns = [&](const int& block, int& begin, int& end) {
+		begin = block * FLOYD_WARSHALL_BLOCK;
+		end = std::min(begin + FLOYD_WARSHALL_BLOCK, stride);
+	};
+	pool.Run([&](int worker) {
+		int k_begin, k_end, k_columns_begin, k_columns_end;
+		for (int k = 0; k < blocks; k++) {
+			rows(k, k_begin, k_end);
+			columns(k, k_columns_begin, k_columns_end);
+			if (worker == 0) {
+				RelaxBlock(matrix, hops, row_length, k_begin, k_end, k_columns_begin, k_columns_end, k_begin, k_end);
+			}
+			pool.Barrier();
+			// The blocks in the row and in the column of the diagonal block only depend on it
+			for (int task = worker; task < 2 * blocks; task += threads) {
+				int other = task / 2;
+				if (other == k) {
+					continue;
+				}
+				int begin, end;
+				if (task % 2 == 0) {
+					columns(other, begin, end);
+					RelaxBlock(matrix, hops, row_length, k_begin, k_end, begin, end, k_begin, k_end);
+				}
+				else {
+					rows(other, begin, end);
+					RelaxBlock(matrix, hops, row_length, begin, end, k_columns_begin, k_columns_end, k_begin, k_end);
+				}
+			}
+			pool.Barrier();
+			// Every other block only depends on the blocks of its row and its column, the threads take whole rows of blocks
+			for (int i = worker; i < blocks; i += threads) {
+				if (i == k) {
+					continue;
+				}
+				int i_begin, i_end;
+				rows(i, i_begin, i_end);
+				for (int j = 0; j < (stride + FLOYD_WARSHALL_BLOCK - 1) / FLOYD_WARSHALL_BLOCK; j++) {
+					if (j == k) {
+						continue;
+					}
+					int j_begin, j_end;
+					columns(j, j_begin, j_end);
+					RelaxBlock(matrix, hops, row_length, i_begin, i_end, j_begin, j_end, k_begin, k_end);
+				}
+			}
+			pool.Barrier();
+		}
+	});
+
+	for (int v = 0; v < vertices; v++) {
+		if (distances[static_cast<size_t>(v) * stride + v] < 0) {
+			std::cerr << "Graph contains negative weight cycle" << std::endl;
+			Clear();
+			return false;
+		}
+	}
+	for (int& distance : distances) {
+		if (distance >= FLOYD_WARSHALL_INFINITY) {
+			distance = INT_MAX;
+		}
+	}
+	return true;
+}
+
+bool DistanceMatrix::BuildJohnson(const WeightedGraph& graph, ThreadPool& pool) {
+	Clear();
+	int vertices = graph.getVertexCount();
+	if (vertices == 0) {
+		std::cerr << "The graph is empty" << std::endl;
+		return false;
+	}
+
+	// The edges in compressed rows, the weights are replaced by the reweighted ones once the potentials are known
+	std::vector<int> begin(vertices + 1, 0);
+	graph.ForEachEdge([&](const int& from, const int& to, const int&) {
+		if (from >= 0 && from < vertices && to >= 0 && to < vertices) {
+			begin[from + 1]++;
+		}
+	});
+	for (int v = 0; v < vertices; v++) {
+		begin[v + 1] += begin[v];
+	}
+	std::vector<int> targets(begin[vertices]);
+	std::vector<long long> weights(begin[vertices]);
+	std::vector<int> fill(begin.begin(), begin.end() - 1);
+	graph.ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		if (from >= 0 && from < vertices && to >= 0 && to < vertices) {
+			targets[fill[from]] = to;
+			weights[fill[from]] = weight;
+			fill[from]++;
+		}
+	});
+
+	// Bellman-Ford from the virtual vertex, which starts every potential at 0. With the virtual vertex the graph has
+	// |V| + 1 vertices, a pass which still lowers a potential after |V| passes is caused by a negative cycle
+	std::vector<long long> potentials(vertices, 0);
+	bool lowered = true;
+	for (int pass = 0; lowered; pass++) {
+		if (pass > vertices) {
+			std::cerr << "Graph contains negative weight cycle" << std::endl;
+			return false;
+		}
+		lowered = false;
+		for (int u = 0; u < vertices; u++) {
+			for (int i = begin[u]; i < begin[u + 1]; i++) {
+				if (potentials[u] + weights[i] < potentials[targets[i]]) {
+					potentials[targets[i]] = potentials[u] + weights[i];
+					lowered = true;
+				}
+			}
+		}
+	}
+	for (int u = 0; u < vertices; u++) {
+		for (int i = begin[u]; i < begin[u + 1]; i++) {
+			weights[i] += potentials[u] - potentials[targets[i]];
+		}
+	}
+
+	if (!Allocate(vertices, INT_MAX)) {
+		return false;
+	}
+
+	// Every worker keeps its own buffers and takes the next source until every row is filled
+	std::atomic<int> next_source(0);
+	pool.Run([&](int) {
+		std::vector<long long> reduced(vertices, LLONG_MAX);
+		std::vector<int> parents(vertices, -1);
+		std::vector<int> order;
+		std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, ReducedComparator> queue;
+		for (int source = next_source.fetch_add(1); source < vertices; source = next_source.fetch_add(1)) {
+			reduced[source] = 0;
+			parents[source] = -1;
+			queue.push({ 0, source });
+			while (!queue.empty()) {
+				long long distance = queue.top().first;
+				int vertex = queue.top().second;
+				queue.pop();
+				if (distance > reduced[vertex]) {
+					continue;
+				}
+				order.push_back(vertex);
+				for (int i = begin[vertex]; i < begin[vertex + 1]; i++) {
+					int next_vertex = targets[i];
+					if (distance + weights[i] < reduced[next_vertex]) {
+						reduced[next_vertex] = distance + weights[i];
+						parents[next_vertex] = vertex;
+						queue.push({ reduced[next_vertex], next_vertex });
+					}
+				}
+			}
+
+			// The vertices are settled after their parents, so the next hop of a parent is known before its children need it
+			int* row = &distances[static_cast<size_t>(source) * stride];
+			int* hops = &next_hops[static_cast<size_t>(source) * stride];
+			for (int vertex : order) {
+				long long distance = reduced[vertex] - potentials[source] + potentials[vertex];
+				row[vertex] = distance >= INT_MAX ? INT_MAX - 1 : distance <= INT_MIN ? INT_MIN : static_cast<int>(distance);
+				hops[vertex] = vertex == source ? source : parents[vertex] == source ? vertex : hops[parents[vertex]];
+				reduced[vertex] = LLONG_MAX;
+			}
+			order.clear();
+		}
+	});
+	return true;
+}
+
+int DistanceMatrix::getDistance(const int& from, const int& to) const {
+	return distances[static_cast<size_t>(from) * stride + to];
+}
+
+int DistanceMatrix::getNextHop(const int& from, const int& to) const {
+	return next_hops[static_cast<size_t>(from) * stride + to];
+}
+
+std::vector<int> DistanceMatrix::FindPath(const int& from, const int& to) const {
+	std::vector<int> path;
+	if (from < 0 || from >= vertex_count || to < 0 || to >= vertex_count || getNextHop(from, to) == -1) {
+		return path;
+	}
+	path.push_back(from);
+	for (int vertex = from; vertex != to && static_cast<int>(path.size()) <= vertex_count; ) {
+		vertex = getNextHop(vertex, to);
+		path.push_back(vertex);
+	}
+	return path;
+}
+
+int DistanceMatrix::getVertexCount() const {
+	return vertex_count;
+}
+
+int DistanceMatrix::getStride() const {
+	return stride;
+}
+
+size_t DistanceMatrix::getMemoryUsage() const {
+	return (distances.capacity() + next_hops.capacity()) * sizeof(int);
+}
@@ -0,0 +1,86 @@
+#include "../headers/Heuristics.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+Heuristic::Heuristic() : Heuristic(HeuristicType::Manhattan, 1) {}
+
+Heuristic::Heuristic(const HeuristicType& type, const int& straight_cost, const int& diagonal_cost)
+	: type(type), straight_cost(straight_cost), min_factor(type == HeuristicType::Octile ? diagonal_cost - 2 * straight_cost : 0), target(0, 0),
+	landmark_tables(nullptr), landmarks(nullptr), stride(0), target_index(0) {}
+
+void Heuristic::setTarget(const sf::Vector2i& target) {
+	this->target = target;
+	AttachLandmarks();
+}
+
+void Heuristic::setLandmarks(const Landmarks* landmarks, const int& stride) {
+	// The tables hold the distances of the straight moves, they do not bound a path with diagonal moves
+	landmark_tables = type == HeuristicType::Manhattan ? landmarks : nullptr;
+	this->stride = stride;
+	AttachLandmarks();
+}
+
+void Heuristic::AttachLandmarks() {
+	target_index = static_cast<uint32_t>(target.y) * stride + target.x;
+	bool inside = target.x >= 0 && target.x < stride && target.y >= 0;
+	landmarks = landmark_tables != nullptr && inside && landmark_tables->Reaches(target_index) ? landmark_tables : nullptr;
+}
+
+const sf::Vector2i& Heuristic::getTarget() const {
+	return target;
+}
+
+HeuristicType Heuristic::getType() const {
+	return type;
+}
+
+void Heuristic::EstimateNeighbours(const int& x, const int& y, const int* dx, const int* dy, const int& count, int* estimates) const {
+	int i = 0;
+	// The offsets are moved to the target first, |target - (cell + offset)| = |(target - cell) - offset|
+	int to_target_x = target.x - x;
+	int to_target_y = target.y - y;
+#if defined(__AVX2__)
+	const __m256i wide_x = _mm256_set1_epi32(to_target_x);
+	const __m256i wide_y = _mm256_set1_epi32(to_target_y);
+	const __m256i wide_straight = _mm256_set1_epi32(straight_cost);
+	const __m256i wide_min_factor = _mm256_set1_epi32(min_factor);
+	for (; i + 8 <= count; i += 8) {
+		__m256i distance_x = _mm256_abs_epi32(_mm256_sub_epi32(wide_x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dx + i))));
+		__m256i distance_y = _mm256_abs_epi32(_mm256_sub_epi32(wide_y, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dy + i))));
+		__m256i straight = _mm256_mullo_epi32(wide_straight, _mm256_add_epi32(distance_x, distance_y));
+		__m256i diagonal = _mm256_mullo_epi32(wide_min_factor, _mm256_min_epi32(distance_x, distance_y));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(estimates + i), _mm256_add_epi32(straight, diagonal));
+	}
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+	const __m128i narrow_x = _mm_set1_epi32(to_target_x);
+	const __m128i narrow_y = _mm_set1_epi32(to_target_y);
+	const __m128i narrow_straight = _mm_set1_epi32(straight_cost);
+	const __m128i narrow_min_factor = _mm_set1_epi32(min_factor);
+	for (; i + 4 <= count; i += 4) {
+		__m128i distance_x = _mm_abs_epi32(_mm_sub_epi32(narrow_x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(dx + i))));
+		__m128i distance_y = _mm_abs_epi32(_mm_sub_epi32(narrow_y, _mm_loadu_si128(reinterpret_cast<const __m128i*>(dy + i))));
+		__m128i straight = _mm_mullo_epi32(narrow_straight, _mm_add_epi32(distance_x, distance_y));
+		__m128i diagonal = _mm_mullo_epi32(narrow_min_factor, _mm_min_epi32(distance_x, distance_y));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(estimates + i), _mm_add_epi32(straight, diagonal));
+	}
+#endif
+	for (; i < count; i++) {
+		int distance_x = std::abs(to_target_x - dx[i]);
+		int distance_y = std::abs(to_target_y - dy[i]);
+		estimates[i] = straight_cost * (distance_x + distance_y) + min_factor * std::min(distance_x, distance_y);
+	}
+	if (landmarks != nullptr) {
+		// The offsets may lead outside of the grid, these neighbours are skipped by the searches and keep the geometric estimate
+		for (i = 0; i < count; i++) {
+			int neighbour_x = x + dx[i];
+			int neighbour_y = y + dy[i];
+			uint32_t index = static_cast<uint32_t>(neighbour_y) * stride + neighbour_x;
+			if (neighbour_x >= 0 && neighbour_x < stride && neighbour_y >= 0 && index < landmarks->getVertexCount()) {
+				estimates[i] = std::max(estimates[i], straight_cost * landmarks->LowerBound(index, target_index));
+			}
+		}
+	}
+}
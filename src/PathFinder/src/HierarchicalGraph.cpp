@@ -0,0 +1,476 @@
+#include "../headers/HierarchicalGraph.hpp"
+
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+
+#define LONG_ENTRANCE 6 // Entrances at least this long get a transition at both ends, the shorter ones one in the middle
+#define NO_DIRECTION 4 // The direction of the source of a search inside a cluster
+
+static const int row_adder[4] = { -1, 0, 1, 0 };
+static const int col_adder[4] = { 0, 1, 0, -1 };
+
+HierarchicalGraph::HierarchicalGraph()
+	: cluster_size(16), clusters_x(0), clusters_y(0), any_dirty(false), search_x(0), search_y(0), local_stride(0), expansions(0), rebuilt_clusters(0) {}
+
+HierarchicalGraph::HierarchicalGraph(const Grid<CellState>& obstacles, const int& cluster_size) : HierarchicalGraph() {
+	setObstacles(obstacles, cluster_size);
+}
+
+void HierarchicalGraph::setObstacles(const Grid<CellState>& obstacles, const int& cluster_size) {
+	cells = obstacles;
+	this->cluster_size = std::min(MAX_CLUSTER_SIZE, std::max(2, cluster_size));
+	clusters_x = (cells.getWidth() + this->cluster_size - 1) / this->cluster_size;
+	clusters_y = (cells.getHeight() + this->cluster_size - 1) / this->cluster_size;
+	int cluster_count = clusters_x * clusters_y;
+
+	clusters.assign(cluster_count, Cluster());
+	borders.assign(2 * static_cast<size_t>(cluster_count), std::vector<std::pair<uint32_t, uint32_t>>());
+	dirty.assign(cluster_count, 0);
+	any_dirty = false;
+	local_stride = this->cluster_size + 2;
+	local_free.assign(static_cast<size_t>(local_stride) * local_stride, 0);
+	local_distances.assign(local_free.size(), -1);
+	local_parents.assign(local_free.size(), NO_DIRECTION);
+	free_rows.assign(local_stride, 0);
+	flood_visited.assign(local_stride, 0);
+	flood_frontier.assign(local_stride, 0);
+	flood_next.assign(local_stride, 0);
+	flood_targets.assign(local_stride, 0);
+
+	// Every border is needed before the nodes of a cluster can be collected
+	for (int cluster = 0; cluster < cluster_count; cluster++) {
+		BuildBorder(cluster, true);
+		BuildBorder(cluster, false);
+	}
+	for (int cluster = 0; cluster < cluster_count; cluster++) {
+		BuildCluster(cluster);
+	}
+}
+
+void HierarchicalGraph::setCell(const int& x, const int& y, const CellState& state) {
+	if (!cells.InBounds(x, y)) {
+		return;
+	}
+	bool was_free = cells(x, y) != Obstacle;
+	cells(x, y) = state;
+	if (was_free != (state != Obstacle)) {
+		dirty[ClusterOf(x, y)] = 1;
+		any_dirty = true;
+	}
+}
+
+int HierarchicalGraph::ClusterOf(const int& x, const int& y) const {
+	return (y / cluster_size) * clusters_x + x / cluster_size;
+}
+
+bool HierarchicalGraph::IsFree(const int& x, const int& y) const {
+	return cells.InBounds(x, y) && cells(x, y) != Obstacle;
+}
+
+void HierarchicalGraph::BuildBorder(const int& cluster, const bool& east) {
+	std::vector<std::pair<uint32_t, uint32_t>>& transitions = borders[2 * static_cast<size_t>(cluster) + (east ? 0 : 1)];
+	transitions.clear();
+	int cluster_x = cluster % clusters_x;
+	int cluster_y = cluster / clusters_x;
+	if ((east && cluster_x + 1 >= clusters_x) || (!east && cluster_y + 1 >= clusters_y)) {
+		return;
+	}
+
+	// The border is the last column (east) or row (south) of the cluster and the first one of its neighbour
+	int length = east ? std::min(cluster_size, cells.getHeight() - cluster_y * cluster_size) : std::min(cluster_size, cells.getWidth() - cluster_x * cluster_size);
+	sf::Vector2i first = east ? sf::Vector2i((cluster_x + 1) * cluster_size - 1, cluster_y * cluster_size) : sf::Vector2i(cluster_x * cluster_size, (cluster_y + 1) * cluster_size - 1);
+	sf::Vector2i along = east ? sf::Vector2i(0, 1) : sf::Vector2i(1, 0);
+	sf::Vector2i across = east ? sf::Vector2i(1, 0) : sf::Vector2i(0, 1);
+	auto add_transition = [&](const int& i) {
+		sf::Vector2i inside = first + along * i;
+		sf::Vector2i outside = inside + across;
+		transitions.push_back({ cells.Index(inside.x, inside.y), cells.Index(outside.x, outside.y) });
+	};
+
+	int run_start = -1;
+	for (int i = 0; i <= length; i++) {
+		sf::Vector2i inside = first + along * i;
+		bool open = i < length && IsFree(inside.x, inside.y) && IsFree(inside.x + across.x, inside.y + across.y);
+		if (open && run_start < 0) {
+			run_start = i;
+		}
+		else if (!open && run_start >= 0) {
+			int run_end = i - 1;
+			if (run_end - run_start + 1 < LONG_ENTRANCE) {
+				add_transition((run_start + run_end) / 2);
+			}
+			else {
+				add_transition(run_start);
+				add_transition(run_end);
+			}
+			run_start = -1;
+		}
+	}
+}
+
+void HierarchicalGraph::BuildCluster(const int& cluster) {
+	Cluster& built = clusters[cluster];
+	built.nodes.clear();
+	built.crossings.clear();
+	auto add_node = [&](const uint32_t& cell, const uint32_t& other) {
+		int index = NodeIndex(cluster, cell);
+		if (index < 0) {
+			index = static_cast<int>(built.nodes.size());
+			built.nodes.push_back(cell);
+			built.crossings.emplace_back();
+		}
+		built.crossings[index].push_back(other);
+	};
+
+	// The east and south borders belong to the cluster, the west and north ones to its neighbours
+	int cluster_x = cluster % clusters_x;
+	int cluster_y = cluster / clusters_x;
+	for (const auto& transition : borders[2 * static_cast<size_t>(cluster)]) {
+		add_node(transition.first, transition.second);
+	}
+	for (const auto& transition : borders[2 * static_cast<size_t>(cluster) + 1]) {
+		add_node(transition.first, transition.second);
+	}
+	if (cluster_x > 0) {
+		for (const auto& transition : borders[2 * static_cast<size_t>(cluster - 1)]) {
+			add_node(transition.second, transition.first);
+		}
+	}
+	if (cluster_y > 0) {
+		for (const auto& transition : borders[2 * static_cast<size_t>(cluster - clusters_x) + 1]) {
+			add_node(transition.second, transition.first);
+		}
+	}
+
+	size_t count = built.nodes.size();
+	built.distances.assign(count * count, -1);
+	LoadCluster(cluster);
+	std::vector<sf::Vector2i> positions(count);
+	for (size_t i = 0; i < count; i++) {
+		positions[i] = sf::Vector2i(cells.CellX(built.nodes[i]) - search_x, cells.CellY(built.nodes[i]) - search_y);
+	}
+	// The distances are symmetric, every node floods only to the nodes after it
+	std::vector<int> flooded(count);
+	for (size_t i = 0; i < count; i++) {
+		built.distances[i * count + i] = 0;
+		if (i + 1 == count) {
+			break;
+		}
+		FloodCluster(positions[i], &positions[i + 1], count - i - 1, flooded.data());
+		for (size_t j = i + 1; j < count; j++) {
+			built.distances[i * count + j] = built.distances[j * count + i] = flooded[j - i - 1];
+		}
+	}
+	rebuilt_clusters++;
+}
+
+void HierarchicalGraph::Rebuild() {
+	if (!any_dirty) {
+		return;
+	}
+	// A changed cell can open or close the entrances of all four borders of its cluster, the nodes of the clusters
+	// on the other side of these borders change with them
+	std::vector<unsigned char> affected(clusters.size(), 0);
+	for (int cluster = 0; cluster < static_cast<int>(clusters.size()); cluster++) {
+		if (!dirty[cluster]) {
+			continue;
+		}
+		int cluster_x = cluster % clusters_x;
+		int cluster_y = cluster / clusters_x;
+		BuildBorder(cluster, true);
+		BuildBorder(cluster, false);
+		affected[cluster] = 1;
+		if (cluster_x + 1 < clusters_x) {
+			affected[cluster + 1] = 1;
+		}
+		if (cluster_y + 1 < clusters_y) {
+			affected[cluster + clusters_x] = 1;
+		}
+		if (cluster_x > 0) {
+			BuildBorder(cluster - 1, true);
+			affected[cluster - 1] = 1;
+		}
+		if (cluster_y > 0) {
+			BuildBorder(cluster - clusters_x, false);
+			affected[cluster - clusters_x] = 1;
+		}
+	}
+	for (int cluster = 0; cluster < static_cast<int>(clusters.size()); cluster++) {
+		if (affected[cluster]) {
+			BuildCluster(cluster);
+		}
+	}
+	std::fill(dirty.begin(), dirty.end(), 0);
+	any_dirty = false;
+}
+
+void HierarchicalGraph::LoadCluster(const int& cluster) {
+	search_x = (cluster % clusters_x) * cluster_size;
+	search_y = (cluster / clusters_x) * cluster_size;
+	int width = std::min(cluster_size, cells.getWidth() - search_x);
+	int height = std::min(cluster_size, cells.getHeight() - search_y);
+	std::fill(local_free.begin(), local_free.end(), 0);
+	std::fill(free_rows.begin(), free_rows.end(), 0);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			bool free = cells(search_x + x, search_y + y) != Obstacle;
+			local_free[(y + 1) * local_stride + x + 1] = free;
+			free_rows[y + 1] |= static_cast<uint64_t>(free) << x;
+		}
+	}
+}
+
+void HierarchicalGraph::FloodCluster(const sf::Vector2i& source, const sf::Vector2i* targets, const size_t& count, int* distances) {
+	std::fill(flood_visited.begin(), flood_visited.end(), 0);
+	std::fill(flood_frontier.begin(), flood_frontier.end(), 0);
+	std::fill(flood_targets.begin(), flood_targets.end(), 0);
+	size_t remaining = 0;
+	for (size_t i = 0; i < count; i++) {
+		distances[i] = -1;
+		if (targets[i] == source) {
+			distances[i] = 0;
+		}
+		else {
+			flood_targets[targets[i].y + 1] |= static_cast<uint64_t>(1) << targets[i].x;
+			remaining++;
+		}
+	}
+	flood_visited[source.y + 1] = flood_frontier[source.y + 1] = static_cast<uint64_t>(1) << source.x;
+
+	// Every step moves the whole frontier by one cell in the four directions, the rows outside of the cluster are never free
+	for (int distance = 1; remaining > 0; distance++) {
+		bool any = false;
+		bool hit = false;
+		for (int y = 1; y <= cluster_size; y++) {
+			uint64_t row = flood_frontier[y];
+			uint64_t reached = (row << 1) | (row >> 1) | flood_frontier[y - 1] | flood_frontier[y + 1];
+			flood_next[y] = reached & free_rows[y] & ~flood_visited[y];
+			any |= flood_next[y] != 0;
+			hit |= (flood_next[y] & flood_targets[y]) != 0;
+		}
+		if (!any) {
+			break;
+		}
+		for (int y = 1; y <= cluster_size; y++) {
+			flood_visited[y] |= flood_next[y];
+		}
+		if (hit) {
+			for (size_t i = 0; i < count; i++) {
+				uint64_t bit = static_cast<uint64_t>(1) << targets[i].x;
+				if (distances[i] < 0 && (flood_next[targets[i].y + 1] & bit)) {
+					distances[i] = distance;
+					flood_targets[targets[i].y + 1] &= ~bit;
+					remaining--;
+				}
+			}
+		}
+		flood_frontier.swap(flood_next);
+	}
+}
+
+long long HierarchicalGraph::SearchCluster(const uint32_t& source) {
+	// The padding keeps the search inside the cluster without bounds checks, the offsets follow row_adder and col_adder
+	const int offsets[4] = { -1, local_stride, 1, -local_stride };
+	std::fill(local_distances.begin(), local_distances.end(), -1);
+	local_queue.clear();
+
+	int source_local = LocalIndex(source);
+	local_distances[source_local] = 0;
+	local_parents[source_local] = NO_DIRECTION;
+	local_queue.push_back(source_local);
+	for (size_t head = 0; head < local_queue.size(); head++) {
+		int local = local_queue[head];
+		int distance = local_distances[local] + 1;
+		for (int i = 0; i < 4; i++) {
+			int next = local + offsets[i];
+			if (!local_free[next] || local_distances[next] != -1) {
+				continue;
+			}
+			local_distances[next] = distance;
+			local_parents[next] = i;
+			local_queue.push_back(next);
+		}
+	}
+	return static_cast<long long>(local_queue.size());
+}
+
+int HierarchicalGraph::LocalIndex(const uint32_t& cell) const {
+	int x = cells.CellX(cell) - search_x;
+	int y = cells.CellY(cell) - search_y;
+	if (x < 0 || x >= cluster_size || y < 0 || y >= cluster_size) {
+		return -1;
+	}
+	return (y + 1) * local_stride + x + 1;
+}
+
+int HierarchicalGraph::NodeIndex(const int& cluster, const uint32_t& cell) const {
+	const std::vector<uint32_t>& nodes = clusters[cluster].nodes;
+	auto found = std::find(nodes.begin(), nodes.end(), cell);
+	return found == nodes.end() ? -1 : static_cast<int>(found - nodes.begin());
+}
+
+std::vector<sf::Vector2i> HierarchicalGraph::FindPath(const sf::Vector2i& start, const sf::Vector2i& end) {
+	std::vector<sf::Vector2i> path;
+	expansions = 0;
+	if (!IsFree(start.x, start.y) || !IsFree(end.x, end.y)) {
+		return path;
+	}
+	Rebuild();
+	if (start == end) {
+		path.push_back(start);
+		return path;
+	}
+
+	uint32_t start_cell = cells.Index(start.x, start.y);
+	uint32_t end_cell = cells.Index(end.x, end.y);
+	int start_cluster = ClusterOf(start.x, start.y);
+	int end_cluster = ClusterOf(end.x, end.y);
+
+	// The distances of the nodes of the end cluster to the end, used when these nodes are expanded
+	LoadCluster(end_cluster);
+	expansions += SearchCluster(end_cell);
+	std::vector<int> to_end(clusters[end_cluster].nodes.size());
+	for (size_t i = 0; i < to_end.size(); i++) {
+		to_end[i] = local_distances[LocalIndex(clusters[end_cluster].nodes[i])];
+	}
+
+	// A* on the abstract graph, the Manhattan distance is consistent because no edge is shorter than it. The entries are
+	// (estimate, heuristic, cell), so of the nodes with the same estimate the one closest to the end is expanded first.
+	typedef std::tuple<int, int, uint32_t> OpenEntry;
+	std::unordered_map<uint32_t, int> best;
+	std::unordered_map<uint32_t, uint32_t> parents;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+	auto estimate = [&](const uint32_t& cell) {
+		return std::abs(end.x - cells.CellX(cell)) + std::abs(end.y - cells.CellY(cell));
+	};
+	auto relax = [&](const uint32_t& from, const uint32_t& to, const int& distance) {
+		auto found = best.find(to);
+		if (found == best.end() || distance < found->second) {
+			best[to] = distance;
+			parents[to] = from;
+			int heuristic = estimate(to);
+			open.push(OpenEntry(distance + heuristic, heuristic, to));
+		}
+	};
+
+	// The start is connected to the nodes of its cluster, and directly to the end if they share the cluster
+	LoadCluster(start_cluster);
+	expansions += SearchCluster(start_cell);
+	for (uint32_t node : clusters[start_cluster].nodes) {
+		int distance = local_distances[LocalIndex(node)];
+		if (distance >= 0) {
+			relax(start_cell, node, distance);
+		}
+	}
+	if (start_cluster == end_cluster && local_distances[LocalIndex(end_cell)] >= 0) {
+		relax(start_cell, end_cell, local_distances[LocalIndex(end_cell)]);
+	}
+
+	bool found_end = false;
+	while (!open.empty()) {
+		uint32_t cell = std::get<2>(open.top());
+		int key = std::get<0>(open.top());
+		open.pop();
+		int distance = best[cell];
+		// Skip the outdated entries, the node was pushed again with a lower cost
+		if (key > distance + estimate(cell)) {
+			continue;
+		}
+		expansions++;
+		if (cell == end_cell) {
+			found_end = true;
+			break;
+		}
+
+		int cluster = ClusterOf(cells.CellX(cell), cells.CellY(cell));
+		int index = NodeIndex(cluster, cell);
+		if (index < 0) {
+			continue;
+		}
+		const Cluster& expanded = clusters[cluster];
+		size_t count = expanded.nodes.size();
+		for (size_t j = 0; j < count; j++) {
+			int inside = expanded.distances[index * count + j];
+			if (static_cast<int>(j) != index && inside >= 0) {
+				relax(cell, expanded.nodes[j], distance + inside);
+			}
+		}
+		for (uint32_t other : expanded.crossings[index]) {
+			relax(cell, other, distance + 1);
+		}
+		if (cluster == end_cluster && to_end[index] >= 0) {
+			relax(cell, end_cell, distance + to_end[index]);
+		}
+	}
+	if (!found_end) {
+		return path;
+	}
+
+	std::vector<uint32_t> abstract_path = { end_cell };
+	while (abstract_path.back() != start_cell) {
+		abstract_path.push_back(parents[abstract_path.back()]);
+	}
+	std::reverse(abstract_path.begin(), abstract_path.end());
+
+	// Refine the chosen segments, a transition is a single move and every other segment stays inside one cluster
+	path.push_back(start);
+	for (size_t k = 1; k < abstract_path.size(); k++) {
+		uint32_t from = abstract_path[k - 1];
+		sf::Vector2i to(cells.CellX(abstract_path[k]), cells.CellY(abstract_path[k]));
+		int cluster = ClusterOf(cells.CellX(from), cells.CellY(from));
+		if (cluster != ClusterOf(to.x, to.y)) {
+			path.push_back(to);
+			continue;
+		}
+		LoadCluster(cluster);
+		expansions += SearchCluster(from);
+		size_t segment_begin = path.size();
+		sf::Vector2i cell = to;
+		while (cells.Index(cell.x, cell.y) != from) {
+			path.push_back(cell);
+			int direction = local_parents[LocalIndex(cells.Index(cell.x, cell.y))];
+			cell.x -= row_adder[direction];
+			cell.y -= col_adder[direction];
+		}
+		std::reverse(path.begin() + segment_begin, path.end());
+	}
+	return path;
+}
+
+int HierarchicalGraph::getClusterSize() const {
+	return cluster_size;
+}
+
+int HierarchicalGraph::getAbstractNodeCount() const {
+	int count = 0;
+	for (const Cluster& cluster : clusters) {
+		count += static_cast<int>(cluster.nodes.size());
+	}
+	return count;
+}
+
+long long HierarchicalGraph::getExpansions() const {
+	return expansions;
+}
+
+long long HierarchicalGraph::getRebuiltClusters() const {
+	return rebuilt_clusters;
+}
+
+size_t HierarchicalGraph::getMemoryUsage() const {
+	size_t bytes = cells.getSize() * sizeof(CellState) + local_free.size() + local_distances.size() * sizeof(int) + local_parents.size();
+	for (const Cluster& cluster : clusters) {
+		bytes += cluster.nodes.size() * sizeof(uint32_t) + cluster.distances.size() * sizeof(int);
+		for (const auto& crossing : cluster.crossings) {
+			bytes += crossing.size() * sizeof(uint32_t);
+		}
+	}
+	for (const auto& border : borders) {
+		bytes += border.size() * sizeof(std::pair<uint32_t, uint32_t>);
+	}
+	return bytes;
+}
@@ -0,0 +1,255 @@
+#include "../headers/IncrementalPlanner.hpp"
+
+#include <climits>
+#include <algorithm>
+
+#define STRAIGHT_COST 70 // Costs of the moves with the diagonal moves, the same as the ones of UnweightedGraph
+#define DIAGONAL_COST 99
+
+// The four straight directions come first, then the four diagonal ones
+static const int direction_x[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int direction_y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+// Adds a cost to a distance, an unknown distance stays unknown
+static inline int AddCost(const int& distance, const int& cost) {
+	return distance == INT_MAX || cost == INT_MAX ? INT_MAX : distance + cost;
+}
+
+IncrementalPlanner::IncrementalPlanner()
+	: heuristic(HeuristicType::Manhattan, 1), start(0, 0), end(0, 0), last_start(0, 0), key_modifier(0), connectivity(Connectivity::Four),
+	corner_cutting(CornerCutting::Forbid), straight_cost(1), expansions(0) {}
+
+void IncrementalPlanner::setObstacles(const Grid<CellState>& obstacles) {
+	this->obstacles = obstacles;
+	g_values.Resize(obstacles.getWidth(), obstacles.getHeight(), INT_MAX);
+	rhs_values.Resize(obstacles.getWidth(), obstacles.getHeight(), INT_MAX);
+	Restart();
+}
+
+void IncrementalPlanner::setConnectivity(const Connectivity& moves, const CornerCutting& corners) {
+	connectivity = moves;
+	corner_cutting = corners;
+	straight_cost = moves == Connectivity::Eight ? STRAIGHT_COST : 1;
+	heuristic = moves == Connectivity::Eight ? Heuristic(HeuristicType::Octile, STRAIGHT_COST, DIAGONAL_COST) : Heuristic(HeuristicType::Manhattan, 1);
+	heuristic.setTarget(start);
+	Restart();
+}
+
+void IncrementalPlanner::setStart(const sf::Vector2i& cell) {
+	if (cell == start) {
+		return;
+	}
+	// The keys queued before the move were estimated from the old start, they are at most the distance moved too high
+	heuristic.setTarget(last_start);
+	key_modifier += heuristic.Estimate(cell.x, cell.y);
+	start = cell;
+	last_start = cell;
+	heuristic.setTarget(start);
+}
+
+void IncrementalPlanner::setEnd(const sf::Vector2i& cell) {
+	end = cell;
+	Restart();
+}
+
+void IncrementalPlanner::Restart() {
+	g_values.Fill(INT_MAX);
+	rhs_values.Fill(INT_MAX);
+	open = std::priority_queue<PlannerKey, std::vector<PlannerKey>, std::greater<PlannerKey>>();
+	key_modifier = 0;
+	last_start = start;
+	heuristic.setTarget(start);
+	expansions = 0;
+	if (!obstacles.InBounds(end.x, end.y)) {
+		return;
+	}
+	uint32_t end_cell = obstacles.Index(end.x, end.y);
+	rhs_values[end_cell] = 0;
+	open.push(CalculateKey(end_cell));
+}
+
+int IncrementalPlanner::MoveCost(const int& x, const int& y, const int& direction) const {
+	int next_x = x + direction_x[direction];
+	int next_y = y + direction_y[direction];
+	if (!obstacles.InBounds(next_x, next_y) || obstacles(x, y) == Obstacle || obstacles(next_x, next_y) == Obstacle) {
+		return INT_MAX;
+	}
+	if (direction < 4) {
+		return straight_cost;
+	}
+	// A diagonal move passes between the two straight neighbours, the rule is the same in both directions
+	if (corner_cutting != CornerCutting::Allow) {
+		bool horizontal_free = obstacles(next_x, y) != Obstacle;
+		bool vertical_free = obstacles(x, next_y) != Obstacle;
+		if (corner_cutting == CornerCutting::Forbid ? !(horizontal_free && vertical_free) : !(horizontal_free || vertical_free)) {
+			return INT_MAX;
+		}
+	}
+	return DIAGONAL_COST;
+}
+
+int IncrementalPlanner::LookAhead(const uint32_t& cell) const {
+	int x = obstacles.CellX(cell);
+	int y = obstacles.CellY(cell);
+	int directions = connectivity == Connectivity::Eight ? 8 : 4;
+	int lowest = INT_MAX;
+	for (int direction = 0; direction < directions; direction++) {
+		int cost = MoveCost(x, y, direction);
+		if (cost != INT_MAX) {
+			lowest = std::min(lowest, AddCost(g_values(x + direction_x[direction], y + direction_y[direction]), cost));
+		}
+	}
+	return lowest;
+}
+
+PlannerKey IncrementalPlanner::CalculateKey(const uint32_t& cell) const {
+	int distance = std::min(g_values[cell], rhs_values[cell]);
+	int estimate = heuristic.Estimate(obstacles.CellX(cell), obstacles.CellY(cell));
+	return { AddCost(distance, estimate + key_modifier), distance, cell };
+}
+
+void IncrementalPlanner::UpdateVertex(const uint32_t& cell) {
+	if (g_values[cell] != rhs_values[cell]) {
+		open.push(CalculateKey(cell));
+	}
+}
+
+void IncrementalPlanner::UpdateCell(const int& x, const int& y, const CellState& state) {
+	if (!obstacles.InBounds(x, y) || (obstacles(x, y) == Obstacle) == (state == Obstacle)) {
+		return;
+	}
+	obstacles(x, y) = state == Obstacle ? Obstacle : Empty;
+	// Only the moves of the cell and the diagonal moves between its neighbours which pass it change their costs
+	uint32_t end_cell = obstacles.Index(end.x, end.y);
+	for (int dy = -1; dy <= 1; dy++) {
+		for (int dx = -1; dx <= 1; dx++) {
+			if (!obstacles.InBounds(x + dx, y + dy)) {
+				continue;
+			}
+			uint32_t cell = obstacles.Index(x + dx, y + dy);
+			if (cell != end_cell) {
+				rhs_values[cell] = LookAhead(cell);
+				UpdateVertex(cell);
+			}
+		}
+	}
+}
+
+bool IncrementalPlanner::ComputeShortestPath() {
+	expansions = 0;
+	if (!obstacles.InBounds(start.x, start.y) || !obstacles.InBounds(end.x, end.y)) {
+		return false;
+	}
+	uint32_t start_cell = obstacles.Index(start.x, start.y);
+	uint32_t end_cell = obstacles.Index(end.x, end.y);
+	int directions = connectivity == Connectivity::Eight ? 8 : 4;
+	while (!open.empty() && (open.top() < CalculateKey(start_cell) || rhs_values[start_cell] > g_values[start_cell])) {
+		PlannerKey queued = open.top();
+		open.pop();
+		uint32_t cell = queued.cell;
+		if (g_values[cell] == rhs_values[cell]) {
+			continue; // Settled since it was queued
+		}
+		PlannerKey current = CalculateKey(cell);
+		if (queued < current) {
+			open.push(current);
+			continue;
+		}
+		expansions++;
+		int x = obstacles.CellX(cell);
+		int y = obstacles.CellY(cell);
+		if (g_values[cell] > rhs_values[cell]) {
+			// The distance dropped, the neighbours may now go through the cell
+			g_values[cell] = rhs_values[cell];
+			for (int direction = 0; direction < directions; direction++) {
+				int cost = MoveCost(x, y, direction);
+				if (cost == INT_MAX) {
+					continue;
+				}
+				uint32_t neighbour = obstacles.Index(x + direction_x[direction], y + direction_y[direction]);
+				int through = AddCost(g_values[cell], cost);
+				if (neighbour != end_cell && through < rhs_values[neighbour]) {
+					rhs_values[neighbour] = through;
+					UpdateVertex(neighbour);
+				}
+			}
+		}
+		else {
+			// The distance rose, the neighbours which went through the cell look ahead again
+			int old_distance = g_values[cell];
+			g_values[cell] = INT_MAX;
+			for (int direction = 0; direction < directions; direction++) {
+				int cost = MoveCost(x, y, direction);
+				if (cost == INT_MAX) {
+					continue;
+				}
+				uint32_t neighbour = obstacles.Index(x + direction_x[direction], y + direction_y[direction]);
+				if (neighbour != end_cell && rhs_values[neighbour] == AddCost(old_distance, cost)) {
+					rhs_values[neighbour] = LookAhead(neighbour);
+					UpdateVertex(neighbour);
+				}
+			}
+			if (cell != end_cell) {
+				rhs_values[cell] = LookAhead(cell);
+			}
+			UpdateVertex(cell);
+		}
+	}
+	return rhs_values[start_cell] != INT_MAX;
+}
+
+std::vector<sf::Vector2i> IncrementalPlanner::FindPath() const {
+	std::vector<sf::Vector2i> path;
+	if (!obstacles.InBounds(start.x, start.y) || !obstacles.InBounds(end.x, end.y) || rhs_values(start.x, start.y) == INT_MAX) {
+		return path;
+	}
+	int directions = connectivity == Connectivity::Eight ? 8 : 4;
+	sf::Vector2i cell = start;
+	path.push_back(cell);
+	// The distances strictly drop along the path, the bound only guards against a path followed before the repair
+	while (cell != end && path.size() <= obstacles.getSize()) {
+		int lowest = INT_MAX;
+		sf::Vector2i next = cell;
+		for (int direction = 0; direction < directions; direction++) {
+			int cost = MoveCost(cell.x, cell.y, direction);
+			if (cost == INT_MAX) {
+				continue;
+			}
+			int through = AddCost(g_values(cell.x + direction_x[direction], cell.y + direction_y[direction]), cost);
+			if (through < lowest) {
+				lowest = through;
+				next = sf::Vector2i(cell.x + direction_x[direction], cell.y + direction_y[direction]);
+			}
+		}
+		if (lowest == INT_MAX) {
+			return std::vector<sf::Vector2i>();
+		}
+		cell = next;
+		path.push_back(cell);
+	}
+	return cell == end ? path : std::vector<sf::Vector2i>();
+}
+
+int IncrementalPlanner::getDistance() const {
+	return obstacles.InBounds(start.x, start.y) ? rhs_values(start.x, start.y) : INT_MAX;
+}
+
+int IncrementalPlanner::getStraightCost() const {
+	return straight_cost;
+}
+
+long long IncrementalPlanner::getExpansions() const {
+	return expansions;
+}
+
+const sf::Vector2i& IncrementalPlanner::getStart() const {
+	return start;
+}
+
+const sf::Vector2i& IncrementalPlanner::getEnd() const {
+	return end;
+}
+
+size_t IncrementalPlanner::getMemoryUsage() const {
+	return obstacles.getSize() * sizeof(CellState) + (g_values.getSize() + rhs_values.getSize()) * sizeof(int) + open.size() * sizeof(PlannerKey);
+}
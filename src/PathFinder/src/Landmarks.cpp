@@ -0,0 +1,473 @@
+#include "../headers/Landmarks.hpp"
+#include "../headers/WeightedGraph.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <queue>
+#include <random>
+
+#define LANDMARK_FILE_VERSION 2
+#define NO_PARENT UINT32_MAX // Parent of the root of a shortest path tree and of the unreached vertices
+
+static const char landmark_file_magic[8] = { 'P', 'F', 'L', 'M', 'A', 'R', 'K', 'S' };
+
+/// \brief The header of a landmark file, followed by the landmarks and the tables, its size is a multiple of 8 bytes so the tables stay aligned.
+struct LandmarkFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t directed;
+	uint32_t vertex_count;
+	uint32_t count;
+	uint32_t width;
+	uint32_t height;
+	uint64_t fingerprint;
+};
+
+// Mixes the bits of a value (the finalizer of SplitMix64), so the sum of the hashes of the edges does not cancel out
+static inline uint64_t MixBits(uint64_t value) {
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+Landmarks::Landmarks() : vertex_count(0), width(0), height(0), fingerprint(0), count(0), directed(false), forward(nullptr), backward(nullptr) {}
+
+bool Landmarks::Build(const Grid<CellState>& obstacles, const int& count, const LandmarkSelection& selection) {
+	Clear();
+	if (count <= 0 || obstacles.getSize() == 0) {
+		std::cerr << "At least one landmark and a non-empty grid are needed" << std::endl;
+		return false;
+	}
+	std::vector<uint32_t> candidates;
+	for (int y = 0; y < obstacles.getHeight(); y++) {
+		for (int x = 0; x < obstacles.getWidth(); x++) {
+			if (obstacles(x, y) != Obstacle) {
+				candidates.push_back(obstacles.Index(x, y));
+			}
+		}
+	}
+	if (candidates.empty()) {
+		std::cerr << "The grid has no free cell for a landmark" << std::endl;
+		return false;
+	}
+
+	vertex_count = static_cast<uint32_t>(obstacles.getSize());
+	width = static_cast<uint32_t>(obstacles.getStride());
+	height = static_cast<uint32_t>(obstacles.getHeight());
+	fingerprint = Fingerprint(obstacles);
+	this->count = count;
+	directed = false;
+	const int row_adder[4] = { -1, 0, 1, 0 };
+	const int col_adder[4] = { 0, 1, 0, -1 };
+	// Breadth First Search with the straight moves, the moves are reversible so the reverse search is the same
+	Select(candidates, selection, [&](const uint32_t& source, const bool&, std::vector<uint32_t>& distances, std::vector<uint32_t>& parents, std::vector<uint32_t>& order) {
+		distances.assign(vertex_count, UNREACHED_DISTANCE);
+		parents.assign(vertex_count, NO_PARENT);
+		order.clear();
+		distances[source] = 0;
+		order.push_back(source);
+		for (size_t head = 0; head < order.size(); head++) {
+			uint32_t cell = order[head];
+			int x = obstacles.CellX(cell);
+			int y = obstacles.CellY(cell);
+			for (int i = 0; i < 4; i++) {
+				int next_x = x + row_adder[i];
+				int next_y = y + col_adder[i];
+				if (!obstacles.InBounds(next_x, next_y) || obstacles(next_x, next_y) == Obstacle) {
+					continue;
+				}
+				uint32_t next = obstacles.Index(next_x, next_y);
+				if (distances[next] == UNREACHED_DISTANCE) {
+					distances[next] = distances[cell] + 1;
+					parents[next] = cell;
+					order.push_back(next);
+				}
+			}
+		}
+	});
+	return true;
+}
+
+bool Landmarks::Build(const WeightedGraph& graph, const int& count, const LandmarkSelection& selection) {
+	Clear();
+	if (count <= 0 || graph.getVertexCount() == 0) {
+		std::cerr << "At least one landmark and a non-empty graph are needed" << std::endl;
+		return false;
+	}
+
+	// Both directions of every edge in compressed arrays, the reverse search runs on the incoming edges
+	uint32_t vertices = static_cast<uint32_t>(graph.getVertexCount());
+	std::vector<uint32_t> out_begin(vertices + 1, 0), in_begin(vertices + 1, 0);
+	bool negative = false;
+	graph.ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		negative = negative || weight < 0;
+		if (from >= 0 && from < static_cast<int>(vertices) && to >= 0 && to < static_cast<int>(vertices)) {
+			out_begin[from + 1]++;
+			in_begin[to + 1]++;
+		}
+	});
+	if (negative) {
+		std::cerr << "Landmarks need non-negative edge weights" << std::endl;
+		return false;
+	}
+	for (uint32_t v = 0; v < vertices; v++) {
+		out_begin[v + 1] += out_begin[v];
+		in_begin[v + 1] += in_begin[v];
+	}
+	std::vector<std::pair<uint32_t, uint32_t>> out_edges(out_begin[vertices]), in_edges(in_begin[vertices]);
+	std::vector<uint32_t> out_fill(out_begin.begin(), out_begin.end() - 1), in_fill(in_begin.begin(), in_begin.end() - 1);
+	graph.ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		if (from >= 0 && from < static_cast<int>(vertices) && to >= 0 && to < static_cast<int>(vertices)) {
+			out_edges[out_fill[from]++] = { static_cast<uint32_t>(to), static_cast<uint32_t>(weight) };
+			in_edges[in_fill[to]++] = { static_cast<uint32_t>(from), static_cast<uint32_t>(weight) };
+		}
+	});
+
+	std::vector<uint32_t> candidates(vertices);
+	for (uint32_t v = 0; v < vertices; v++) {
+		candidates[v] = v;
+	}
+	vertex_count = vertices;
+	width = vertices;
+	height = 1;
+	fingerprint = Fingerprint(graph);
+	this->count = count;
+	directed = true;
+	Select(candidates, selection, [&](const uint32_t& source, const bool& reverse, std::vector<uint32_t>& distances, std::vector<uint32_t>& parents, std::vector<uint32_t>& order) {
+		const std::vector<uint32_t>& begin = reverse ? in_begin : out_begin;
+		const std::vector<std::pair<uint32_t, uint32_t>>& edges = reverse ? in_edges : out_edges;
+		distances.assign(vertex_count, UNREACHED_DISTANCE);
+		parents.assign(vertex_count, NO_PARENT);
+		order.clear();
+		std::priority_queue<std::pair<uint32_t, uint32_t>, std::vector<std::pair<uint32_t, uint32_t>>, std::greater<std::pair<uint32_t, uint32_t>>> queue;
+		distances[source] = 0;
+		queue.push({ 0, source });
+		while (!queue.empty()) {
+			uint32_t distance = queue.top().first;
+			uint32_t vertex = queue.top().second;
+			queue.pop();
+			if (distance > distances[vertex]) {
+				continue;
+			}
+			order.push_back(vertex);
+			for (uint32_t i = begin[vertex]; i < begin[vertex + 1]; i++) {
+				uint32_t next = edges[i].first;
+				uint32_t next_distance = distance + edges[i].second;
+				if (next_distance < distances[next]) {
+					distances[next] = next_distance;
+					parents[next] = vertex;
+					queue.push({ next_distance, next });
+				}
+			}
+		}
+	});
+	return true;
+}
+
+void Landmarks::Select(const std::vector<uint32_t>& candidates, const LandmarkSelection& selection, const Search& search) {
+	size_t table_size = static_cast<size_t>(vertex_count) * count;
+	storage.assign(directed ? 2 * table_size : table_size, UNREACHED_DISTANCE);
+	AttachStorage();
+	uint32_t* forward_tables = storage.data();
+	uint32_t* backward_tables = directed ? storage.data() + table_size : storage.data();
+
+	// The seed is fixed, so the same graph always gets the same landmarks
+	std::mt19937 generator(12345);
+	std::uniform_int_distribution<size_t> candidate_distribution(0, candidates.size() - 1);
+	std::vector<uint32_t> distances, parents, order;
+	std::vector<uint32_t> nearest(vertex_count, UNREACHED_DISTANCE); // Distance from or to the closest landmark
+	std::vector<unsigned char> is_landmark(vertex_count, 0);
+	std::vector<uint64_t> sizes;
+	std::vector<unsigned char> covered;
+	std::vector<uint32_t> best_child;
+
+	for (int k = 0; k < count; k++) {
+		uint32_t landmark = NO_PARENT;
+		uint32_t root = candidates[candidate_distribution(generator)];
+		if (k == 0 || selection == LandmarkSelection::Avoid) {
+			search(root, false, distances, parents, order);
+		}
+
+		if (k == 0 && selection == LandmarkSelection::Farthest) {
+			landmark = order.back(); // The vertices are settled by their distance, the last one is the farthest
+		}
+		else if (selection == LandmarkSelection::Avoid) {
+			// The weight of a vertex is how much the chosen landmarks underestimate its distance from the root, the size of a
+			// subtree is the sum of its weights, or zero if it contains a landmark. The new landmark is the leaf reached by always
+			// stepping to the largest child.
+			sizes.assign(vertex_count, 0);
+			covered.assign(vertex_count, 0);
+			best_child.assign(vertex_count, NO_PARENT);
+			for (uint32_t vertex : order) {
+				uint32_t bound = 0;
+				for (int i = 0; i < k; i++) {
+					uint32_t from_root = forward_tables[static_cast<size_t>(root) * count + i];
+					uint32_t from_vertex = forward_tables[static_cast<size_t>(vertex) * count + i];
+					if (from_vertex != UNREACHED_DISTANCE && from_root < from_vertex) {
+						bound = std::max(bound, from_vertex - from_root);
+					}
+					uint32_t to_root = backward_tables[static_cast<size_t>(root) * count + i];
+					uint32_t to_vertex = backward_tables[static_cast<size_t>(vertex) * count + i];
+					if (to_root != UNREACHED_DISTANCE && to_vertex < to_root) {
+						bound = std::max(bound, to_root - to_vertex);
+					}
+				}
+				sizes[vertex] = distances[vertex] - bound;
+				covered[vertex] = is_landmark[vertex];
+			}
+			// Children are settled after their parents, so walking the order backwards finishes every subtree before its root
+			for (size_t i = order.size(); i-- > 1;) {
+				uint32_t vertex = order[i];
+				uint32_t parent = parents[vertex];
+				if (covered[vertex]) {
+					sizes[vertex] = 0;
+					covered[parent] = 1;
+					continue;
+				}
+				sizes[parent] += sizes[vertex];
+				if (best_child[parent] == NO_PARENT || sizes[vertex] > sizes[best_child[parent]]) {
+					best_child[parent] = vertex;
+				}
+			}
+			landmark = root;
+			while (best_child[landmark] != NO_PARENT && sizes[best_child[landmark]] > 0) {
+				landmark = best_child[landmark];
+			}
+		}
+
+		if (landmark == NO_PARENT || is_landmark[landmark]) {
+			// Farthest point selection, also used when the tree of the root is already covered by the landmarks
+			uint32_t farthest_distance = 0;
+			for (uint32_t candidate : candidates) {
+				if (nearest[candidate] != UNREACHED_DISTANCE && !is_landmark[candidate] && nearest[candidate] > farthest_distance) {
+					farthest_distance = nearest[candidate];
+					landmark = candidate;
+				}
+			}
+			if (landmark == NO_PARENT || is_landmark[landmark]) {
+				break; // Every reachable vertex is already a landmark
+			}
+		}
+
+		is_landmark[landmark] = 1;
+		landmark_vertices.push_back(landmark);
+		search(landmark, false, distances, parents, order);
+		for (uint32_t v = 0; v < vertex_count; v++) {
+			forward_tables[static_cast<size_t>(v) * count + k] = distances[v];
+			nearest[v] = std::min(nearest[v], distances[v]);
+		}
+		if (directed) {
+			search(landmark, true, distances, parents, order);
+			for (uint32_t v = 0; v < vertex_count; v++) {
+				backward_tables[static_cast<size_t>(v) * count + k] = distances[v];
+				nearest[v] = std::min(nearest[v], distances[v]);
+			}
+		}
+	}
+
+	// Fewer landmarks were placed than asked for, the tables are packed to the placed ones
+	int placed = static_cast<int>(landmark_vertices.size());
+	if (placed < count) {
+		std::vector<uint32_t> packed(storage.size() / count * placed);
+		for (size_t row = 0; row < storage.size() / count; row++) {
+			std::copy(storage.begin() + row * count, storage.begin() + row * count + placed, packed.begin() + row * placed);
+		}
+		storage.swap(packed);
+		count = placed;
+		AttachStorage();
+	}
+}
+
+void Landmarks::AttachStorage() {
+	size_t table_size = static_cast<size_t>(vertex_count) * count;
+	forward = storage.data();
+	backward = directed ? storage.data() + table_size : storage.data();
+}
+
+bool Landmarks::Save(const std::string& path) const {
+	std::ofstream output(path, std::ios::binary);
+	if (!output) {
+		std::cerr << "Could not write the landmark file " << path << std::endl;
+		return false;
+	}
+	LandmarkFileHeader header;
+	std::memcpy(header.magic, landmark_file_magic, sizeof(header.magic));
+	header.version = LANDMARK_FILE_VERSION;
+	header.directed = directed ? 1 : 0;
+	header.vertex_count = vertex_count;
+	header.count = static_cast<uint32_t>(count);
+	header.width = width;
+	header.height = height;
+	header.fingerprint = fingerprint;
+	size_t table_size = static_cast<size_t>(vertex_count) * count;
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(landmark_vertices.data()), landmark_vertices.size() * sizeof(uint32_t));
+	output.write(reinterpret_cast<const char*>(forward), table_size * sizeof(uint32_t));
+	if (directed) {
+		output.write(reinterpret_cast<const char*>(backward), table_size * sizeof(uint32_t));
+	}
+	if (!output) {
+		std::cerr << "Could not write the landmark file " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool Landmarks::Load(const std::string& path, const Grid<CellState>& obstacles) {
+	if (!Map(path)) {
+		return false;
+	}
+	if (!Matches(obstacles)) {
+		std::cerr << "The landmark file " << path << " was built for another map" << std::endl;
+		Clear();
+		return false;
+	}
+	return true;
+}
+
+bool Landmarks::Load(const std::string& path, const WeightedGraph& graph) {
+	if (!Map(path)) {
+		return false;
+	}
+	if (!Matches(graph)) {
+		std::cerr << "The landmark file " << path << " was built for another graph" << std::endl;
+		Clear();
+		return false;
+	}
+	return true;
+}
+
+bool Landmarks::Matches(const Grid<CellState>& obstacles) const {
+	return !directed && vertex_count == obstacles.getSize() && width == static_cast<uint32_t>(obstacles.getStride())
+		&& height == static_cast<uint32_t>(obstacles.getHeight()) && fingerprint == Fingerprint(obstacles);
+}
+
+bool Landmarks::Matches(const WeightedGraph& graph) const {
+	return directed && vertex_count == static_cast<uint32_t>(graph.getVertexCount()) && fingerprint == Fingerprint(graph);
+}
+
+uint64_t Landmarks::Fingerprint(const Grid<CellState>& obstacles) {
+	// FNV-1a over the size and one byte per cell, the padding of the rows included
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto add = [&hash](const uint64_t& value) {
+		hash = (hash ^ value) * 0x100000001B3ull;
+	};
+	add(static_cast<uint64_t>(obstacles.getStride()));
+	add(static_cast<uint64_t>(obstacles.getHeight()));
+	const CellState* cells = obstacles.getData();
+	for (size_t i = 0; i < obstacles.getSize(); i++) {
+		add(cells[i] == Obstacle ? 1 : 0);
+	}
+	return hash;
+}
+
+uint64_t Landmarks::Fingerprint(const WeightedGraph& graph) {
+	// The edges are summed, so the hash does not depend on whether they are read from the rows or from the added edges
+	uint64_t hash = MixBits(static_cast<uint64_t>(graph.getVertexCount()));
+	graph.ForEachEdge([&hash](const int& from, const int& to, const int& weight) {
+		hash += MixBits((static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32 | static_cast<uint32_t>(to)) ^ MixBits(static_cast<uint32_t>(weight)));
+	});
+	return hash;
+}
+
+bool Landmarks::Map(const std::string& path) {
+	Clear();
+	if (!file.Open(path)) {
+		return false;
+	}
+	LandmarkFileHeader header;
+	if (file.getSize() < sizeof(header)) {
+		std::cerr << "The landmark file " << path << " is too short" << std::endl;
+		Clear();
+		return false;
+	}
+	std::memcpy(&header, file.getData(), sizeof(header));
+	if (std::memcmp(header.magic, landmark_file_magic, sizeof(header.magic)) != 0 || header.version != LANDMARK_FILE_VERSION) {
+		std::cerr << "The file " << path << " is not a landmark file of this version" << std::endl;
+		Clear();
+		return false;
+	}
+	size_t most_words = file.getSize() / sizeof(uint32_t);
+	if (header.count > most_words || (header.vertex_count > 0 && header.count > most_words / header.vertex_count)) { // The expected size would overflow
+		std::cerr << "The landmark file " << path << " has " << file.getSize() << " bytes, too few for its table sizes" << std::endl;
+		Clear();
+		return false;
+	}
+	size_t table_size = static_cast<size_t>(header.vertex_count) * header.count;
+	size_t expected = sizeof(header) + (header.count + (header.directed ? 2 : 1) * table_size) * sizeof(uint32_t);
+	if (file.getSize() != expected) {
+		std::cerr << "The landmark file " << path << " has " << file.getSize() << " bytes, expected " << expected << std::endl;
+		Clear();
+		return false;
+	}
+
+	vertex_count = header.vertex_count;
+	width = header.width;
+	height = header.height;
+	fingerprint = header.fingerprint;
+	count = static_cast<int>(header.count);
+	directed = header.directed != 0;
+	const uint32_t* words = reinterpret_cast<const uint32_t*>(file.getData() + sizeof(header));
+	for (int i = 0; i < count; i++) {
+		if (words[i] >= vertex_count) {
+			std::cerr << "The landmark file " << path << " is corrupted, landmark " << i << " is vertex " << words[i] << " of " << vertex_count << std::endl;
+			Clear();
+			return false;
+		}
+	}
+	landmark_vertices.assign(words, words + count);
+	forward = words + count;
+	backward = directed ? forward + table_size : forward;
+	return true;
+}
+
+void Landmarks::Clear() {
+	file.Close();
+	storage.clear();
+	landmark_vertices.clear();
+	vertex_count = 0;
+	width = 0;
+	height = 0;
+	fingerprint = 0;
+	count = 0;
+	directed = false;
+	forward = nullptr;
+	backward = nullptr;
+}
+
+bool Landmarks::Reaches(const uint32_t& vertex) const {
+	if (vertex >= vertex_count) {
+		return false;
+	}
+	for (int i = 0; i < count; i++) {
+		if (forward[static_cast<size_t>(vertex) * count + i] != UNREACHED_DISTANCE || backward[static_cast<size_t>(vertex) * count + i] != UNREACHED_DISTANCE) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int Landmarks::getCount() const {
+	return count;
+}
+
+uint32_t Landmarks::getVertexCount() const {
+	return vertex_count;
+}
+
+uint32_t Landmarks::getWidth() const {
+	return width;
+}
+
+const std::vector<uint32_t>& Landmarks::getLandmarks() const {
+	return landmark_vertices;
+}
+
+bool Landmarks::isDirected() const {
+	return directed;
+}
+
+size_t Landmarks::getMemoryUsage() const {
+	return static_cast<size_t>(vertex_count) * count * (directed ? 2 : 1) * sizeof(uint32_t);
+}
@@ -0,0 +1,483 @@
+#include "../headers/MapLoader.hpp"
+#include "../headers/MappedFile.hpp"
+#include "../headers/ThreadPool.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <cstring>
+#include <climits>
+
+bool MapLoader::LoadGrid(const std::string& path, Grid<CellState>& grid, sf::Vector2i& start, sf::Vector2i& end) {
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << "Could not open the grid file " << path << std::endl;
+		return false;
+	}
+
+	std::vector<std::string> rows;
+	std::string line;
+	size_t width = 0;
+	while (std::getline(file, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (line.empty() || line[0] == ';') {
+			continue;
+		}
+		width = std::max(width, line.size());
+		rows.push_back(line);
+	}
+	if (rows.empty()) {
+		std::cerr << "The grid file " << path << " is empty" << std::endl;
+		return false;
+	}
+
+	grid.Resize(static_cast<int>(width), static_cast<int>(rows.size()), Empty);
+	for (int y = 0; y < static_cast<int>(rows.size()); y++) {
+		for (int x = 0; x < static_cast<int>(rows[y].size()); x++) {
+			switch (rows[y][x]) {
+			case '#':
+			case '@':
+				grid(x, y) = Obstacle;
+				break;
+			case 'S':
+				start = sf::Vector2i(x, y);
+				break;
+			case 'E':
+				end = sf::Vector2i(x, y);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+bool MapLoader::LoadMovingAIMap(const std::string& path, Grid<CellState>& grid) {
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << "Could not open the map file " << path << std::endl;
+		return false;
+	}
+
+	// The header is "type octile", "height H", "width W" and "map" in this order
+	std::string key;
+	int width = -1;
+	int height = -1;
+	while (file >> key && key != "map") {
+		if (key == "height") {
+			file >> height;
+		}
+		else if (key == "width") {
+			file >> width;
+		}
+		else if (key == "type") {
+			file >> key;
+		}
+		else {
+			std::cerr << "Unknown header " << key << " in " << path << std::endl;
+			return false;
+		}
+	}
+	if (key != "map" || width <= 0 || height <= 0) {
+		std::cerr << "The map file " << path << " has no size" << std::endl;
+		return false;
+	}
+
+	grid.Resize(width, height, Empty);
+	std::string line;
+	std::getline(file, line);
+	for (int y = 0; y < height; y++) {
+		if (!std::getline(file, line)) {
+			std::cerr << "The map file " << path << " has " << y << " of " << height << " rows" << std::endl;
+			return false;
+		}
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (static_cast<int>(line.size()) < width) {
+			std::cerr << "Row " << y << " of " << path << " is shorter than the width" << std::endl;
+			return false;
+		}
+		for (int x = 0; x < width; x++) {
+			switch (line[x]) {
+			case '.':
+			case 'G':
+			case 'S':
+				break;
+			case '@':
+			case 'O':
+			case 'T':
+			case 'W':
+				grid(x, y) = Obstacle;
+				break;
+			default:
+				std::cerr << "Unknown cell '" << line[x] << "' in row " << y << " of " << path << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool MapLoader::LoadMovingAIScenario(const std::string& path, std::vector<ScenarioQuery>& queries) {
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << "Could not open the scenario file " << path << std::endl;
+		return false;
+	}
+
+	queries.clear();
+	std::string line;
+	int line_number = 0;
+	while (std::getline(file, line)) {
+		line_number++;
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (line.empty() || line.compare(0, 7, "version") == 0) {
+			continue;
+		}
+		std::istringstream stream(line);
+		ScenarioQuery query;
+		if (!(stream >> query.bucket >> query.map >> query.width >> query.height >> query.start.x >> query.start.y
+			>> query.end.x >> query.end.y >> query.optimal_length)) {
+			std::cerr << "Invalid query on line " << line_number << " of " << path << std::endl;
+			return false;
+		}
+		queries.push_back(query);
+	}
+	if (queries.empty()) {
+		std::cerr << "The scenario file " << path << " has no queries" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Skips the spaces and tabs of a line
+static inline const char* SkipBlanks(const char* at, const char* end) {
+	while (at < end && (*at == ' ' || *at == '\t')) {
+		at++;
+	}
+	return at;
+}
+
+// Reads a decimal integer after blanks, returns nullptr if there are no digits or the number does not fit in an int. The digits
+// are summed without an overflow check, a number of more than 10 digits never fits
+static inline const char* ScanInteger(const char* at, const char* end, int& value) {
+	at = SkipBlanks(at, end);
+	bool negative = at < end && *at == '-';
+	at += negative;
+	const char* digits = at;
+	unsigned long long number = 0;
+	while (at < end && static_cast<unsigned>(*at - '0') < 10u) {
+		number = number * 10 + static_cast<unsigned>(*at - '0');
+		at++;
+	}
+	if (at == digits || at - digits > 10 || number > static_cast<unsigned long long>(INT_MAX) + negative) {
+		return nullptr;
+	}
+	value = negative ? static_cast<int>(-static_cast<long long>(number)) : static_cast<int>(number);
+	return at;
+}
+
+// Reads a word after blanks, returns nullptr if the line continues with something else
+static inline const char* ScanWord(const char* at, const char* end, const char* word) {
+	at = SkipBlanks(at, end);
+	size_t length = std::strlen(word);
+	if (static_cast<size_t>(end - at) < length || std::memcmp(at, word, length) != 0) {
+		return nullptr;
+	}
+	return at + length;
+}
+
+// Checks that only blanks follow the last field of a line
+static inline bool EndOfLine(const char* at, const char* end) {
+	if (at == nullptr) {
+		return false;
+	}
+	at = SkipBlanks(at, end);
+	return at == end || *at == '\r';
+}
+
+/// \struct ParsedChunk
+/// \brief A part of a mapped graph file read by one worker, and what was read from it.
+template<typename Record>
+struct ParsedChunk {
+	const char* begin = nullptr;      ///< First byte of the part, the start of a line.
+	const char* end = nullptr;        ///< Byte after the part, the start of a line or the end of the file.
+	std::vector<Record> records;      ///< Records of the lines, in the order of the file.
+	int header_vertices = -1;         ///< Number of vertices of the problem line, -1 if the part does not have it.
+	int max_vertex = -1;              ///< Highest vertex of the records.
+	const char* error = nullptr;      ///< The line which could not be read, nullptr if every line was read.
+};
+
+/// \struct VertexCoordinate
+/// \brief A line of a DIMACS coordinate file.
+struct VertexCoordinate {
+	int vertex;  ///< The vertex, numbered from 0.
+	int x;       ///< The first coordinate.
+	int y;       ///< The second coordinate.
+};
+
+// Maps a file, splits it into one part per worker at line breaks and reads the lines of every part on its worker
+template<typename Record, typename LineParser>
+static bool ParseChunks(const std::string& path, ThreadPool& pool, std::vector<ParsedChunk<Record>>& chunks, LineParser parse_line) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	const char* data = file.getData();
+	size_t size = file.getSize();
+	int count = pool.getThreadCount();
+	chunks.assign(count, ParsedChunk<Record>());
+	for (int c = 0; c < count; c++) {
+		size_t offset = size * c / count;
+		const char* begin = data + offset;
+		if (offset > 0) {
+			const char* line_break = static_cast<const char*>(std::memchr(data + offset - 1, '\n', size - offset + 1));
+			begin = line_break != nullptr ? line_break + 1 : data + size;
+		}
+		chunks[c].begin = begin;
+		if (c > 0) {
+			chunks[c - 1].end = begin;
+		}
+	}
+	chunks[count - 1].end = data + size;
+
+	pool.Run([&](int worker) {
+		ParsedChunk<Record>& chunk = chunks[worker];
+		chunk.records.reserve(static_cast<size_t>(chunk.end - chunk.begin) / LOADER_BYTES_PER_LINE);
+		const char* line = chunk.begin;
+		while (line < chunk.end) {
+			const char* line_end = static_cast<const char*>(std::memchr(line, '\n', chunk.end - line));
+			if (line_end == nullptr) {
+				line_end = chunk.end;
+			}
+			if (!parse_line(line, line_end, chunk)) {
+				chunk.error = line;
+				return;
+			}
+			line = line_end < chunk.end ? line_end + 1 : chunk.end;
+		}
+	});
+
+	for (const ParsedChunk<Record>& chunk : chunks) {
+		if (chunk.error != nullptr) {
+			std::cerr << "Invalid line " << std::count(data, chunk.error, '\n') + 1 << " of " << path << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Packs the edges of the parts into compressed sparse rows on every worker. The vertices are split into ranges, the edges are
+// sorted into the ranges part by part (stable), then every worker counts the degrees of its ranges and moves their edges into the rows
+static bool BuildRows(std::vector<ParsedChunk<GraphEdge>>& chunks, const int& vertices, ThreadPool& pool, WeightedGraph& graph,
+	const std::string& path) {
+	size_t edge_count = 0;
+	for (const ParsedChunk<GraphEdge>& chunk : chunks) {
+		edge_count += chunk.records.size();
+	}
+	if (edge_count > static_cast<size_t>(INT_MAX)) {
+		std::cerr << "Too many edges in " << path << std::endl;
+		return false;
+	}
+	int count = static_cast<int>(chunks.size());
+	int range_size = std::max(1, (vertices + count * LOADER_RANGES_PER_THREAD - 1) / (count * LOADER_RANGES_PER_THREAD));
+	int ranges = std::max(1, (vertices + range_size - 1) / range_size);
+	// Edges of every part in every range, then the position of the first of them in the sorted edges
+	std::vector<size_t> positions;
+	std::vector<size_t> range_begin;
+	std::unique_ptr<GraphEdge[]> sorted;
+	std::vector<int> offsets;
+	std::vector<int> targets;
+	std::vector<int> weights;
+	// Allocated here and not on a worker, so a graph which does not fit in memory is reported instead of ending the program
+	try {
+		positions.assign(static_cast<size_t>(count) * ranges, 0);
+		range_begin.assign(static_cast<size_t>(ranges) + 1, 0);
+		sorted.reset(new GraphEdge[edge_count]);
+		offsets.assign(static_cast<size_t>(vertices) + 1, 0);
+		targets.resize(edge_count);
+		weights.resize(edge_count);
+	}
+	catch (const std::bad_alloc&) {
+		std::cerr << "Not enough memory for the " << vertices << " vertices and " << edge_count << " edges of " << path << std::endl;
+		return false;
+	}
+
+	pool.Run([&](int worker) {
+		size_t* counts = positions.data() + static_cast<size_t>(worker) * ranges;
+		for (const GraphEdge& edge : chunks[worker].records) {
+			counts[edge.from / range_size]++;
+		}
+		pool.Barrier();
+		if (worker == 0) {
+			size_t total = 0;
+			for (int r = 0; r < ranges; r++) {
+				range_begin[r] = total;
+				for (int c = 0; c < count; c++) {
+					size_t edges = positions[static_cast<size_t>(c) * ranges + r];
+					positions[static_cast<size_t>(c) * ranges + r] = total;
+					total += edges;
+				}
+			}
+			range_begin[ranges] = total;
+		}
+		pool.Barrier();
+		for (const GraphEdge& edge : chunks[worker].records) {
+			sorted[counts[edge.from / range_size]++] = edge;
+		}
+		std::vector<GraphEdge>().swap(chunks[worker].records);
+		pool.Barrier();
+		std::vector<int> fill(range_size);
+		for (int r = worker; r < ranges; r += count) {
+			int first = r * range_size;
+			int last = std::min(vertices, first + range_size);
+			for (size_t i = range_begin[r]; i < range_begin[r + 1]; i++) {
+				offsets[sorted[i].from + 1]++;
+			}
+			int edge = static_cast<int>(range_begin[r]);
+			for (int v = first; v < last; v++) {
+				fill[v - first] = edge;
+				edge += offsets[v + 1];
+				offsets[v + 1] = edge;
+			}
+			for (size_t i = range_begin[r]; i < range_begin[r + 1]; i++) {
+				int position = fill[sorted[i].from - first]++;
+				targets[position] = sorted[i].to;
+				weights[position] = sorted[i].weight;
+			}
+		}
+	});
+	graph.LoadCompressedRows(vertices, std::move(offsets), std::move(targets), std::move(weights));
+	return true;
+}
+
+bool MapLoader::LoadEdgeList(const std::string& path, WeightedGraph& graph, ThreadPool& pool) {
+	std::vector<ParsedChunk<GraphEdge>> chunks;
+	bool parsed = ParseChunks(path, pool, chunks, [](const char* at, const char* end, ParsedChunk<GraphEdge>& chunk) {
+		at = SkipBlanks(at, end);
+		if (at == end || *at == '#' || *at == '\r') {
+			return true;
+		}
+		GraphEdge edge;
+		if ((at = ScanInteger(at, end, edge.from)) == nullptr || (at = ScanInteger(at, end, edge.to)) == nullptr
+			|| !EndOfLine(ScanInteger(at, end, edge.weight), end) || edge.from < 0 || edge.to < 0 || edge.from >= LOADER_MAX_VERTICES
+			|| edge.to >= LOADER_MAX_VERTICES) {
+			return false;
+		}
+		chunk.records.push_back(edge);
+		chunk.max_vertex = std::max(chunk.max_vertex, std::max(edge.from, edge.to));
+		return true;
+	});
+	if (!parsed) {
+		return false;
+	}
+
+	int max_vertex = -1;
+	for (const ParsedChunk<GraphEdge>& chunk : chunks) {
+		max_vertex = std::max(max_vertex, chunk.max_vertex);
+	}
+	return BuildRows(chunks, max_vertex + 1, pool, graph, path);
+}
+
+bool MapLoader::LoadDimacs(const std::string& path, WeightedGraph& graph, ThreadPool& pool) {
+	std::vector<ParsedChunk<GraphEdge>> chunks;
+	bool parsed = ParseChunks(path, pool, chunks, [](const char* at, const char* end, ParsedChunk<GraphEdge>& chunk) {
+		at = SkipBlanks(at, end);
+		if (at == end || *at == 'c' || *at == '\r') {
+			return true;
+		}
+		if (*at == 'p') {
+			int edges;
+			return (at = ScanWord(at + 1, end, "sp")) != nullptr && (at = ScanInteger(at, end, chunk.header_vertices)) != nullptr
+				&& EndOfLine(ScanInteger(at, end, edges), end) && chunk.header_vertices >= 0 && chunk.header_vertices <= LOADER_MAX_VERTICES;
+		}
+		GraphEdge edge;
+		if (*at != 'a' || (at = ScanInteger(at + 1, end, edge.from)) == nullptr || (at = ScanInteger(at, end, edge.to)) == nullptr
+			|| !EndOfLine(ScanInteger(at, end, edge.weight), end) || edge.from < 1 || edge.to < 1) {
+			return false;
+		}
+		edge.from--;
+		edge.to--;
+		chunk.records.push_back(edge);
+		chunk.max_vertex = std::max(chunk.max_vertex, std::max(edge.from, edge.to));
+		return true;
+	});
+	if (!parsed) {
+		return false;
+	}
+
+	int vertices = -1;
+	int max_vertex = -1;
+	for (const ParsedChunk<GraphEdge>& chunk : chunks) {
+		vertices = std::max(vertices, chunk.header_vertices);
+		max_vertex = std::max(max_vertex, chunk.max_vertex);
+	}
+	if (vertices < 0) {
+		std::cerr << "The graph file " << path << " has no problem line" << std::endl;
+		return false;
+	}
+	if (max_vertex >= vertices) {
+		std::cerr << "An edge of " << path << " leads to vertex " << max_vertex + 1 << " of " << vertices << std::endl;
+		return false;
+	}
+	return BuildRows(chunks, vertices, pool, graph, path);
+}
+
+bool MapLoader::LoadDimacsCoordinates(const std::string& path, std::vector<sf::Vector2i>& coordinates, ThreadPool& pool) {
+	std::vector<ParsedChunk<VertexCoordinate>> chunks;
+	bool parsed = ParseChunks(path, pool, chunks, [](const char* at, const char* end, ParsedChunk<VertexCoordinate>& chunk) {
+		at = SkipBlanks(at, end);
+		if (at == end || *at == 'c' || *at == '\r') {
+			return true;
+		}
+		if (*at == 'p') {
+			return (at = ScanWord(at + 1, end, "aux")) != nullptr && (at = ScanWord(at, end, "sp")) != nullptr
+				&& (at = ScanWord(at, end, "co")) != nullptr && EndOfLine(ScanInteger(at, end, chunk.header_vertices), end)
+				&& chunk.header_vertices >= 0;
+		}
+		VertexCoordinate coordinate;
+		if (*at != 'v' || (at = ScanInteger(at + 1, end, coordinate.vertex)) == nullptr || (at = ScanInteger(at, end, coordinate.x)) == nullptr
+			|| !EndOfLine(ScanInteger(at, end, coordinate.y), end) || coordinate.vertex < 1) {
+			return false;
+		}
+		coordinate.vertex--;
+		chunk.records.push_back(coordinate);
+		chunk.max_vertex = std::max(chunk.max_vertex, coordinate.vertex);
+		return true;
+	});
+	if (!parsed) {
+		return false;
+	}
+
+	int vertices = -1;
+	int max_vertex = -1;
+	for (const ParsedChunk<VertexCoordinate>& chunk : chunks) {
+		vertices = std::max(vertices, chunk.header_vertices);
+		max_vertex = std::max(max_vertex, chunk.max_vertex);
+	}
+	if (vertices < 0) {
+		std::cerr << "The coordinate file " << path << " has no problem line" << std::endl;
+		return false;
+	}
+	if (max_vertex >= vertices) {
+		std::cerr << "The coordinate file " << path << " places vertex " << max_vertex + 1 << " of " << vertices << std::endl;
+		return false;
+	}
+	coordinates.assign(vertices, sf::Vector2i(0, 0));
+	for (const ParsedChunk<VertexCoordinate>& chunk : chunks) {
+		for (const VertexCoordinate& coordinate : chunk.records) {
+			coordinates[coordinate.vertex] = sf::Vector2i(coordinate.x, coordinate.y);
+		}
+	}
+	return true;
+}
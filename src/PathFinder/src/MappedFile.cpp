@@ -0,0 +1,113 @@
+#include "../headers/MappedFile.hpp"
+
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+MappedFile::MappedFile() : data(nullptr), size(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr) {}
+#else
+MappedFile::MappedFile() : data(nullptr), size(0), descriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+#if defined(_WIN32)
+	file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		std::cerr << "Could not open the file " << path << std::endl;
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) {
+		std::cerr << "The file " << path << " is empty" << std::endl;
+		Close();
+		return false;
+	}
+	mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_handle == nullptr) {
+		std::cerr << "Could not map the file " << path << std::endl;
+		Close();
+		return false;
+	}
+	data = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		std::cerr << "Could not map the file " << path << std::endl;
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(file_size.QuadPart);
+#else
+	descriptor = open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		std::cerr << "Could not open the file " << path << std::endl;
+		return false;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+		std::cerr << "The file " << path << " is empty" << std::endl;
+		Close();
+		return false;
+	}
+	void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+	if (mapping == MAP_FAILED) {
+		std::cerr << "Could not map the file " << path << std::endl;
+		Close();
+		return false;
+	}
+	data = static_cast<const char*>(mapping);
+	size = static_cast<size_t>(status.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::Close() {
+#if defined(_WIN32)
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mapping_handle != nullptr) {
+		CloseHandle(mapping_handle);
+	}
+	if (file_handle != INVALID_HANDLE_VALUE) {
+		CloseHandle(file_handle);
+	}
+	mapping_handle = nullptr;
+	file_handle = INVALID_HANDLE_VALUE;
+#else
+	if (data != nullptr) {
+		munmap(const_cast<char*>(data), size);
+	}
+	if (descriptor >= 0) {
+		close(descriptor);
+	}
+	descriptor = -1;
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+bool MappedFile::isOpen() const {
+	return data != nullptr;
+}
+
+const char* MappedFile::getData() const {
+	return data;
+}
+
+size_t MappedFile::getSize() const {
+	return size;
+}
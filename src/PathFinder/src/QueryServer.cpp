@@ -0,0 +1,249 @@
+#include "../headers/QueryServer.hpp"
+#include "../headers/ThreadPool.hpp"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Set by SIGINT and SIGTERM on any thread, the thread reading the sockets checks it at least every SERVER_POLL_INTERVAL
+static std::atomic<bool> stop_requested(false);
+
+static void RequestStop(int) {
+	int saved_errno = errno;
+	stop_requested = true;
+	errno = saved_errno;
+}
+
+QueryServer::Client::Client(const int& descriptor) : descriptor(descriptor), broken(false) {}
+
+QueryServer::Client::~Client() {
+#if !defined(_WIN32)
+	if (descriptor >= 0) {
+		close(descriptor);
+	}
+#endif
+}
+
+void QueryServer::Client::Write(const std::string& answer) {
+	std::lock_guard<std::mutex> lock(writing);
+	if (broken) {
+		return;
+	}
+	if (descriptor < 0) {
+		std::cout << answer << std::endl;
+		broken = !std::cout;
+		return;
+	}
+#if !defined(_WIN32)
+	std::string line = answer + '\n';
+	size_t written = 0;
+	while (written < line.size()) {
+		ssize_t count = send(descriptor, line.data() + written, line.size() - written, 0);
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+		if (count <= 0) {
+			broken = true; // The client is gone, SIGPIPE is ignored while the socket is served
+			return;
+		}
+		written += static_cast<size_t>(count);
+	}
+#endif
+}
+
+QueryServer::QueryServer(ThreadPool& pool) : pool(pool), stopped(false), answered(0) {}
+
+void QueryServer::Push(const std::shared_ptr<Client>& client, std::string&& line) {
+	std::unique_lock<std::mutex> lock(mutex);
+	taken.wait(lock, [&] { return requests.size() < SERVER_QUEUE_LIMIT; });
+	requests.push_back({ client, std::move(line) });
+	lock.unlock();
+	queued.notify_one();
+}
+
+bool QueryServer::Pop(Request& request) {
+	std::unique_lock<std::mutex> lock(mutex);
+	queued.wait(lock, [&] { return stopped || !requests.empty(); });
+	if (requests.empty()) {
+		return false;
+	}
+	request = std::move(requests.front());
+	requests.pop_front();
+	lock.unlock();
+	taken.notify_one();
+	return true;
+}
+
+void QueryServer::Stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+	queued.notify_all();
+}
+
+void QueryServer::Run(const std::function<void()>& reader, const Handler& handler) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = false;
+		requests.clear();
+	}
+	std::thread reading([&]() {
+		reader();
+		Stop();
+	});
+	pool.Run([&](int worker) {
+		Request request;
+		while (Pop(request)) {
+			request.client->Write(handler(worker, request.line));
+			request.client.reset(); // The last answer of a client which hung up closes its socket
+			answered++;
+		}
+	});
+	reading.join();
+}
+
+void QueryServer::ServeStandardStreams(const Handler& handler) {
+	std::shared_ptr<Client> output = std::make_shared<Client>(-1);
+	Run([&]() {
+		std::string line;
+		while (std::getline(std::cin, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			if (!line.empty()) {
+				Push(output, std::move(line));
+			}
+		}
+	}, handler);
+}
+
+bool QueryServer::ServeSocket(const std::string& path, const Handler& handler) {
+#if defined(_WIN32)
+	std::cerr << "Unix domain sockets are not available on this platform, serve the standard streams with --serve -" << std::endl;
+	return false;
+#else
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "The socket path " << path << " is empty or longer than " << sizeof(address.sun_path) - 1 << " characters" << std::endl;
+		return false;
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	// A socket nobody accepts on was left by a server which did not stop cleanly, a server which still runs keeps its socket
+	struct stat status;
+	if (lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+		int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+		bool running = probe >= 0 && connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+		if (probe >= 0) {
+			close(probe);
+		}
+		if (running) {
+			std::cerr << "Another server listens on " << path << std::endl;
+			return false;
+		}
+		unlink(path.c_str());
+	}
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+		std::cerr << "Could not listen on " << path << ": " << std::strerror(errno) << std::endl;
+		if (listener >= 0) {
+			close(listener);
+		}
+		return false;
+	}
+	fcntl(listener, F_SETFD, FD_CLOEXEC);
+
+	stop_requested = false;
+	void (*previous_pipe)(int) = std::signal(SIGPIPE, SIG_IGN);
+	void (*previous_interrupt)(int) = std::signal(SIGINT, RequestStop);
+	void (*previous_terminate)(int) = std::signal(SIGTERM, RequestStop);
+	Run([&]() {
+		struct Connection {
+			std::shared_ptr<Client> client;  // Shared with the queued requests of the client
+			std::string pending;             // Bytes after the last line break
+		};
+		std::vector<Connection> connections;
+		std::vector<pollfd> descriptors;
+		std::vector<char> buffer(SERVER_READ_SIZE);
+		while (!stop_requested) {
+			descriptors.assign(1, { listener, POLLIN, 0 });
+			for (const Connection& connection : connections) {
+				descriptors.push_back({ connection.client->descriptor, POLLIN, 0 });
+			}
+			int ready = poll(descriptors.data(), descriptors.size(), SERVER_POLL_INTERVAL);
+			if (ready < 0 && errno != EINTR) {
+				std::cerr << "Could not wait for the clients: " << std::strerror(errno) << std::endl;
+				return;
+			}
+			if (ready <= 0) {
+				continue;
+			}
+			// The connections accepted now are after the ones polled, so descriptor i + 1 still belongs to connection i
+			if (descriptors[0].revents & POLLIN) {
+				int descriptor = accept(listener, nullptr, nullptr);
+				if (descriptor >= 0) {
+					fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+					connections.push_back({ std::make_shared<Client>(descriptor), std::string() });
+				}
+			}
+			for (size_t i = descriptors.size(); i-- > 1;) {
+				if (descriptors[i].revents == 0) {
+					continue;
+				}
+				Connection& connection = connections[i - 1];
+				ssize_t count = read(descriptors[i].fd, buffer.data(), buffer.size());
+				if (count < 0 && errno == EINTR) {
+					continue;
+				}
+				if (count > 0) {
+					connection.pending.append(buffer.data(), static_cast<size_t>(count));
+				}
+				else {
+					connection.pending += '\n'; // A client which hung up still gets the answer to its last line
+				}
+				size_t begin = 0;
+				size_t line_break;
+				while ((line_break = connection.pending.find('\n', begin)) != std::string::npos) {
+					size_t end = line_break > begin && connection.pending[line_break - 1] == '\r' ? line_break - 1 : line_break;
+					if (end > begin) {
+						Push(connection.client, connection.pending.substr(begin, end - begin));
+					}
+					begin = line_break + 1;
+				}
+				connection.pending.erase(0, begin);
+				if (connection.pending.size() > SERVER_MAX_LINE) {
+					std::cerr << "A client sent a request longer than " << SERVER_MAX_LINE << " bytes, it was disconnected" << std::endl;
+				}
+				if (count <= 0 || connection.pending.size() > SERVER_MAX_LINE) {
+					connections.erase(connections.begin() + (i - 1));
+				}
+			}
+		}
+	}, handler);
+	std::signal(SIGPIPE, previous_pipe);
+	std::signal(SIGINT, previous_interrupt);
+	std::signal(SIGTERM, previous_terminate);
+	close(listener);
+	unlink(path.c_str());
+	return true;
+#endif
+}
+
+long long QueryServer::getAnswered() const {
+	return answered;
+}
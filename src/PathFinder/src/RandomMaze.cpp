@@ -8,7 +8,7 @@ RandomMaze::RandomMaze(const int& rows_number, const int& cols_number) {
 	cols = cols_number;
 	current_row_for_random_maze = 0;
 	current_col_for_random_maze = 0;
-    grid.resize(rows, std::vector<CellState>(cols, CellState::Obstacle));
+	grid.Resize(cols, rows, CellState::Obstacle);
 }
 
 std::vector<std::pair<int, int>> RandomMaze::getNeighbors(const int& x, const int& y) {
@@ -37,9 +37,9 @@ void RandomMaze::GenerateRecursiveBacktrackerMaze() {
 
 		std::vector<std::pair<int, int>> neighbors = getNeighbors(x, y);
 		for (auto& neighbor : neighbors) {
-			if (grid[neighbor.second][neighbor.first] == CellState::Obstacle) {
-				grid[neighbor.second][neighbor.first] = CellState::Empty;
-				grid[(neighbor.second + y) / 2][(neighbor.first + x) / 2] = CellState::Empty;
+			if (grid(neighbor.first, neighbor.second) == CellState::Obstacle) {
+				grid(neighbor.first, neighbor.second) = CellState::Empty;
+				grid((neighbor.first + x) / 2, (neighbor.second + y) / 2) = CellState::Empty;
 				backtracker_maze_stack.push(neighbor);
 			}
 		}
@@ -51,7 +51,7 @@ void RandomMaze::GenerateRecursiveBacktrackerMaze() {
 }
 
 void RandomMaze::SetUpRecursiveBacktrackerMaze(const sf::Vector2i& starting_point, const sf::Vector2i& ending_point) {
-	grid.assign(rows, std::vector<CellState>(cols, CellState::Obstacle));
+	grid.Fill(CellState::Obstacle);
 	finished = false;
 	while (!backtracker_maze_stack.empty()) {
 		backtracker_maze_stack.pop();
@@ -59,17 +59,17 @@ void RandomMaze::SetUpRecursiveBacktrackerMaze(const sf::Vector2i& starting_poin
 	start = starting_point;
 	end = ending_point;
 	backtracker_maze_stack.push({ start.x, start.y });
-	grid[start.x][start.y] = CellState::Obstacle;
+	grid(start.x, start.y) = CellState::Obstacle;
 }
 
 void RandomMaze::GenerateRandomMaze() {
 	if (current_row_for_random_maze < rows) {
 		if (current_col_for_random_maze < cols) {
 			if ((rand() % 3) == 0) {
-				grid[current_col_for_random_maze][current_row_for_random_maze] = Obstacle;
+				grid(current_col_for_random_maze, current_row_for_random_maze) = Obstacle;
 			}
 			else {
-				grid[current_col_for_random_maze][current_row_for_random_maze] = Empty;
+				grid(current_col_for_random_maze, current_row_for_random_maze) = Empty;
 			}
 			current_col_for_random_maze++;
 		}
@@ -83,7 +83,7 @@ void RandomMaze::GenerateRandomMaze() {
 	}
 }
 
-std::vector<std::vector<CellState>> RandomMaze::getGrid() {
+const Grid<CellState>& RandomMaze::getGrid() const {
 	return grid;
 }
 
@@ -97,6 +97,8 @@ bool RandomMaze::getFinished() {
 	return finished;
 }
 
-void RandomMaze::setGrid(const std::vector<std::vector<CellState>>& replacement_grid) {
+void RandomMaze::setGrid(const Grid<CellState>& replacement_grid) {
 	grid = replacement_grid;
+	rows = grid.getHeight();
+	cols = grid.getWidth();
 }
\ No newline at end of file
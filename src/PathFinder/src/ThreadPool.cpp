@@ -0,0 +1,80 @@
+#include "../headers/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(const int& threads)
+	: thread_count(threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency())), job(nullptr), job_generation(0),
+	running(0), stopping(false), barrier_waiting(0), barrier_generation(0) {
+	// hardware_concurrency may not know the number of hardware threads and return 0
+	if (thread_count < 1) {
+		thread_count = 1;
+	}
+	for (int worker = 1; worker < thread_count; worker++) {
+		this->threads.emplace_back(&ThreadPool::Work, this, worker);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	job_ready.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::Work(const int& worker) {
+	unsigned generation = 0;
+	while (true) {
+		const std::function<void(int)>* current;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			job_ready.wait(lock, [&] { return stopping || job_generation != generation; });
+			if (stopping) {
+				return;
+			}
+			generation = job_generation;
+			current = job;
+		}
+		(*current)(worker);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running--;
+		}
+		job_done.notify_one();
+	}
+}
+
+void ThreadPool::Run(const std::function<void(int)>& job) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		running = thread_count - 1;
+		job_generation++;
+	}
+	job_ready.notify_all();
+	job(0);
+	std::unique_lock<std::mutex> lock(mutex);
+	job_done.wait(lock, [&] { return running == 0; });
+	this->job = nullptr;
+}
+
+void ThreadPool::Barrier() {
+	// The generation is read before arriving, the last worker to arrive resets the count and releases the others
+	unsigned generation = barrier_generation.load(std::memory_order_acquire);
+	if (barrier_waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == thread_count) {
+		barrier_waiting.store(0, std::memory_order_relaxed);
+		barrier_generation.fetch_add(1, std::memory_order_release);
+		return;
+	}
+	int spins = 0;
+	while (barrier_generation.load(std::memory_order_acquire) == generation) {
+		if (++spins > BARRIER_SPINS) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+int ThreadPool::getThreadCount() const {
+	return thread_count;
+}
@@ -2,12 +2,16 @@
 #include "../headers/Button.hpp"
 #include "../headers/UnweightedGraph.hpp"
 #include "../headers/RandomMaze.hpp"
+#include "../headers/IncrementalPlanner.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
-const int GRID_SIZE = 25; // Number of cells in each row/column
-const int CELL_SIZE = 25; // Size of each cell in pixels
+const int GRID_AREA = 625; // Size of the square the grid is fitted into, in pixels
+const int DEFAULT_GRID_CELLS = 25 * 25; // Number of cells of the default grid, larger grids run more steps per tick
+const float MIN_OUTLINED_CELL_SIZE = 4.0f; // Cells smaller than this are drawn without the outlines
 
 const int OFFSET = 20; // Offset of the grid from the edge of the window
 
@@ -18,26 +22,39 @@ enum class AlgorithmPicked {
     Dijkstra,
     AStar,
     GBFS,
+    JPS,
+    JPSPlus,
+    BitboardBFS,
+    BidirectionalBFS,
+    BidirectionalDijkstra,
+    BidirectionalAStar,
     RandomMaze,
     RandomBacktrackerMaze
 };
 
+// Write the color of a cell to the RGBA pixels of the grid texture
+static void SetPixel(std::vector<sf::Uint8>& pixels, const size_t& index, const sf::Color& color) {
+    pixels[4 * index] = color.r;
+    pixels[4 * index + 1] = color.g;
+    pixels[4 * index + 2] = color.b;
+    pixels[4 * index + 3] = color.a;
+}
+
+UnweightedAlgorithmsPage::UnweightedAlgorithmsPage(const int& width, const int& height) {
+    grid_width = width;
+    grid_height = height;
+}
+
 void UnweightedAlgorithmsPage::ResetGridAfterAlgorithm() {
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            if (obstacles[i][j] != Obstacle) {
-                obstacles[i][j] = Empty;
-            }
+    for (size_t i = 0; i < obstacles.getSize(); ++i) {
+        if (obstacles[i] != Obstacle) {
+            obstacles[i] = Empty;
         }
     }
 }
 
 void UnweightedAlgorithmsPage::ResetGrid() {
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            obstacles[i][j] = Empty;
-        }
-    }
+    obstacles.Fill(Empty);
 }
 
 void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
@@ -53,14 +70,33 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
         return;
     }
 
-    std::vector<std::vector<sf::RectangleShape>> grid(GRID_SIZE, std::vector<sf::RectangleShape>(GRID_SIZE));
-    obstacles.resize(GRID_SIZE, std::vector<CellState>(GRID_SIZE, Empty));
+    if (grid_width <= 0 || grid_height <= 0 || static_cast<unsigned>(std::max(grid_width, grid_height)) > sf::Texture::getMaximumSize()) {
+        std::cerr << "The grid " << grid_width << "x" << grid_height << " can not be displayed" << std::endl;
+        return;
+    }
+    obstacles.Resize(grid_width, grid_height, Empty);
+
+    // The whole grid is one texture with a pixel per cell, scaled to fit the grid area
+    float cell_size = std::min(static_cast<float>(GRID_AREA) / grid_width, static_cast<float>(GRID_AREA) / grid_height);
+    std::vector<sf::Uint8> pixels(obstacles.getSize() * 4);
+    sf::Texture grid_texture;
+    if (!grid_texture.create(grid_width, grid_height)) {
+        std::cerr << "Could not create the texture of the grid" << std::endl;
+        return;
+    }
+    sf::Sprite grid_sprite(grid_texture);
+    grid_sprite.setPosition(OFFSET, OFFSET);
+    grid_sprite.setScale(cell_size, cell_size);
+    const sf::Color cell_colors[] = { sf::Color::White, sf::Color::Black, sf::Color::Yellow, sf::Color::Magenta }; // Indexed by CellState
+
+    // Larger grids run more steps per tick, so a search takes about as long as on the default grid
+    const long long steps_per_tick = std::max(1LL, static_cast<long long>(obstacles.getSize()) / DEFAULT_GRID_CELLS);
     
     sf::Vector2i start(0, 0);
-    sf::Vector2i end(GRID_SIZE - 1, GRID_SIZE - 1);
+    sf::Vector2i end(grid_width - 1, grid_height - 1);
     
     UnweightedGraph graph(obstacles, start, end);
-    RandomMaze random_maze(GRID_SIZE, GRID_SIZE);
+    RandomMaze random_maze(grid_height, grid_width);
 
     // Set up of the buttons
     Button reset_button("Reset grid", { 350, 100 }, sf::Color(255, 32, 78), sf::Color::White);
@@ -103,13 +139,63 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
     gbfs_button.setFont(font);
     gbfs_button.setPosition({ 680, 380 });
 
-    // Initializing the grid for later use, setting the positions
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            grid[i][j].setSize(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-            grid[i][j].setPosition(OFFSET + i * CELL_SIZE, OFFSET + j * CELL_SIZE);
-            grid[i][j].setOutlineThickness(1);
-            grid[i][j].setOutlineColor(sf::Color::Black);
+    Button jps_button("JPS", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    jps_button.setHoverColor(sf::Color(160, 21, 62));
+    jps_button.setFont(font);
+    jps_button.setPosition({ 680, 470 });
+
+    Button jps_plus_button("JPS+", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    jps_plus_button.setHoverColor(sf::Color(160, 21, 62));
+    jps_plus_button.setFont(font);
+    jps_plus_button.setPosition({ 680, 560 });
+
+    Button bitboard_bfs_button("Bitboard BFS", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    bitboard_bfs_button.setHoverColor(sf::Color(160, 21, 62));
+    bitboard_bfs_button.setFont(font);
+    bitboard_bfs_button.setPosition({ 680, 650 });
+
+    Button bidirectional_bfs_button("Bidir. BFS", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    bidirectional_bfs_button.setHoverColor(sf::Color(160, 21, 62));
+    bidirectional_bfs_button.setFont(font);
+    bidirectional_bfs_button.setPosition({ 680, 740 });
+
+    Button bidirectional_dijkstra_button("Bidir. Dijkstra", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    bidirectional_dijkstra_button.setHoverColor(sf::Color(160, 21, 62));
+    bidirectional_dijkstra_button.setFont(font);
+    bidirectional_dijkstra_button.setPosition({ 680, 830 });
+
+    Button bidirectional_a_star_button("Bidir. A Star", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    bidirectional_a_star_button.setHoverColor(sf::Color(160, 21, 62));
+    bidirectional_a_star_button.setFont(font);
+    bidirectional_a_star_button.setPosition({ 680, 920 });
+
+    Button d_star_lite_button("D* Lite", { 300, 70 }, sf::Color(255, 32, 78), sf::Color::White);
+    d_star_lite_button.setHoverColor(sf::Color(160, 21, 62));
+    d_star_lite_button.setFont(font);
+    d_star_lite_button.setPosition({ 20, 800 });
+
+    // After D* Lite was picked, the path is repaired whenever a cell, the start or the end changes
+    IncrementalPlanner planner;
+    bool replanning = false;
+    auto replan = [&]() {
+        bool found = planner.ComputeShortestPath();
+        ResetGridAfterAlgorithm();
+        for (const sf::Vector2i& cell : planner.FindPath()) {
+            obstacles(cell.x, cell.y) = Route;
+        }
+        std::cout << "D* Lite expanded " << planner.getExpansions() << " cells" << (found ? "" : ", the end can not be reached") << std::endl;
+    };
+
+    // The outlines of the cells, only drawn if the cells are large enough to see them
+    sf::VertexArray grid_lines(sf::Lines);
+    if (cell_size >= MIN_OUTLINED_CELL_SIZE) {
+        for (int x = 0; x <= grid_width; ++x) {
+            grid_lines.append(sf::Vertex(sf::Vector2f(OFFSET + x * cell_size, OFFSET), sf::Color::Black));
+            grid_lines.append(sf::Vertex(sf::Vector2f(OFFSET + x * cell_size, OFFSET + grid_height * cell_size), sf::Color::Black));
+        }
+        for (int y = 0; y <= grid_height; ++y) {
+            grid_lines.append(sf::Vertex(sf::Vector2f(OFFSET, OFFSET + y * cell_size), sf::Color::Black));
+            grid_lines.append(sf::Vertex(sf::Vector2f(OFFSET + grid_width * cell_size, OFFSET + y * cell_size), sf::Color::Black));
         }
     }
 
@@ -132,6 +218,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (bfs_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::BFS;
+                    replanning = false;
                     ResetGridAfterAlgorithm();
                     graph.setObstacles(obstacles);
                     graph.SetUpBFS();
@@ -140,6 +227,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (dfs_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::DFS;
+                    replanning = false;
                     ResetGridAfterAlgorithm();
                     graph.setObstacles(obstacles);
                     graph.SetUpDFS();
@@ -148,6 +236,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (dijkstra_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::Dijkstra;
+                    replanning = false;
                     ResetGridAfterAlgorithm();
                     graph.setObstacles(obstacles);
                     graph.SetUpDijkstra();
@@ -156,6 +245,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (a_star_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::AStar;
+                    replanning = false;
                     ResetGridAfterAlgorithm();
                     graph.setObstacles(obstacles);
                     graph.SetUpAStar();
@@ -164,13 +254,82 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (gbfs_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::GBFS;
+                    replanning = false;
                     ResetGridAfterAlgorithm();
                     graph.setObstacles(obstacles);
                     graph.SetUpGBFS();
                 }
             }
+            else if (jps_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::JPS;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpJPS();
+                }
+            }
+            else if (jps_plus_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::JPSPlus;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpJPSPlus();
+                }
+            }
+            else if (bitboard_bfs_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::BitboardBFS;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpBitboardBFS();
+                }
+            }
+            else if (bidirectional_bfs_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::BidirectionalBFS;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpBidirectionalBFS();
+                }
+            }
+            else if (bidirectional_dijkstra_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::BidirectionalDijkstra;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpBidirectionalDijkstra();
+                }
+            }
+            else if (bidirectional_a_star_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::BidirectionalAStar;
+                    replanning = false;
+                    ResetGridAfterAlgorithm();
+                    graph.setObstacles(obstacles);
+                    graph.SetUpBidirectionalAStar();
+                }
+            }
+            else if (d_star_lite_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    algoritm_picker = AlgorithmPicked::None;
+                    graph.ResetAlgorithm();
+                    ResetGridAfterAlgorithm();
+                    planner.setConnectivity(graph.getConnectivity(), graph.getCornerCutting());
+                    planner.setObstacles(obstacles);
+                    planner.setStart(start);
+                    planner.setEnd(end);
+                    replanning = true;
+                    replan();
+                }
+            }
             else if (reset_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    replanning = false;
                     ResetGrid();
                     graph.ResetAlgorithm();
                     graph.setObstacles(obstacles);
@@ -180,6 +339,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (random_maze_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left ) {
                     algoritm_picker = AlgorithmPicked::RandomMaze;
+                    replanning = false;
                     ResetGrid();
                     random_maze.setGrid(obstacles);
                     random_maze.SetUpRandomMaze();
@@ -188,6 +348,7 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             else if (recursive_backtracker_maze_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     algoritm_picker = AlgorithmPicked::RandomBacktrackerMaze;
+                    replanning = false;
                     ResetGrid();
                     random_maze.setGrid(obstacles);
                     random_maze.SetUpRecursiveBacktrackerMaze(start, end);
@@ -216,6 +377,28 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
                 else if (event.key.code == sf::Keyboard::E) {
                     is_end_key_held = true;
                 }
+                else if (event.key.code == sf::Keyboard::D || event.key.code == sf::Keyboard::C) {
+                    // D toggles the diagonal moves, C switches to the next corner cutting rule
+                    Connectivity moves = graph.getConnectivity();
+                    CornerCutting corners = graph.getCornerCutting();
+                    if (event.key.code == sf::Keyboard::D) {
+                        moves = moves == Connectivity::Eight ? Connectivity::Four : Connectivity::Eight;
+                    }
+                    else {
+                        corners = corners == CornerCutting::Allow ? CornerCutting::ForbidIfBothBlocked
+                            : corners == CornerCutting::ForbidIfBothBlocked ? CornerCutting::Forbid : CornerCutting::Allow;
+                    }
+                    algoritm_picker = AlgorithmPicked::None;
+                    ResetGridAfterAlgorithm(); // The obstacles are kept, only the path of the last search is removed
+                    graph.setObstacles(obstacles);
+                    graph.setConnectivity(moves, corners);
+                    if (replanning) {
+                        planner.setConnectivity(moves, corners);
+                        replan();
+                    }
+                    std::cout << (moves == Connectivity::Eight ? "Diagonal moves, corner cutting: " : "Straight moves, corner cutting: ")
+                        << (corners == CornerCutting::Allow ? "allowed" : corners == CornerCutting::Forbid ? "forbidden" : "forbidden if both sides are blocked") << std::endl;
+                }
             }
             else if (event.type == sf::Event::KeyReleased) {
                 if (event.key.code == sf::Keyboard::S) {
@@ -232,34 +415,46 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             int mouse_x_coordinate = sf::Mouse::getPosition(window).x;
             int mouse_y_coordinate = sf::Mouse::getPosition(window).y;
 
-            int cell_x_coordinate = (mouse_x_coordinate - OFFSET) / CELL_SIZE;
-            int cell_y_coordinate = (mouse_y_coordinate - OFFSET) / CELL_SIZE;
+            int cell_x_coordinate = static_cast<int>(std::floor((mouse_x_coordinate - OFFSET) / cell_size));
+            int cell_y_coordinate = static_cast<int>(std::floor((mouse_y_coordinate - OFFSET) / cell_size));
             
 
             if (is_start_key_held) {
-                if (cell_x_coordinate >= 0 && cell_x_coordinate < GRID_SIZE && cell_y_coordinate >= 0 && cell_y_coordinate < GRID_SIZE) {
+                if (obstacles.InBounds(cell_x_coordinate, cell_y_coordinate)) {
                     start.x = cell_x_coordinate;
                     start.y = cell_y_coordinate;
                     graph.setStart(start); // Resetting the start in the grid
                     graph.ResetAlgorithm(); // Reset the algorithm so it doesn't cause any undefined behaviour
                     algoritm_picker = AlgorithmPicked::None;
+                    if (replanning && planner.getStart() != start) {
+                        planner.setStart(start); // The distances to the end stay valid, only the new start is searched for
+                        replan();
+                    }
                 }
             }
 
             else if (is_end_key_held) {
-                if (cell_x_coordinate >= 0 && cell_x_coordinate < GRID_SIZE && cell_y_coordinate >= 0 && cell_y_coordinate < GRID_SIZE) {
+                if (obstacles.InBounds(cell_x_coordinate, cell_y_coordinate)) {
                     end.x = cell_x_coordinate;
                     end.y = cell_y_coordinate;
                     graph.setEnd(end); // Resetting the end in the grid
                     graph.ResetAlgorithm(); // Reset the algorithm so it doesn't cause any undefined behaviour
                     algoritm_picker = AlgorithmPicked::None;
+                    if (replanning && planner.getEnd() != end) {
+                        planner.setEnd(end); // The distances were measured to the old end, the search starts over
+                        replan();
+                    }
                 }
             }
-            else if (cell_x_coordinate >= 0 && cell_x_coordinate < GRID_SIZE && cell_y_coordinate >= 0 && cell_y_coordinate < GRID_SIZE) {
+            else if (obstacles.InBounds(cell_x_coordinate, cell_y_coordinate)) {
                 if (last_x_coordinate == -1 || last_x_coordinate != cell_x_coordinate || last_y_coordinate != cell_y_coordinate) {
-                    obstacles[cell_x_coordinate][cell_y_coordinate] = Obstacle;
+                    obstacles(cell_x_coordinate, cell_y_coordinate) = Obstacle;
                     graph.ResetAlgorithm();
                     graph.setObstacles(obstacles);
+                    if (replanning) {
+                        planner.UpdateCell(cell_x_coordinate, cell_y_coordinate, Obstacle);
+                        replan();
+                    }
                     algoritm_picker = AlgorithmPicked::None;
                     last_x_coordinate = cell_x_coordinate;
                     last_y_coordinate = cell_y_coordinate;
@@ -270,54 +465,49 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             int mouse_x_coordinate = sf::Mouse::getPosition(window).x;
             int mouse_y_coordinate = sf::Mouse::getPosition(window).y;
 
-            int cell_x_coordinate = (mouse_x_coordinate - OFFSET) / CELL_SIZE;
-            int cell_y_coordinate = (mouse_y_coordinate - OFFSET) / CELL_SIZE;
-            if (cell_x_coordinate >= 0 && cell_x_coordinate < GRID_SIZE && cell_y_coordinate >= 0 && cell_y_coordinate < GRID_SIZE) {
+            int cell_x_coordinate = static_cast<int>(std::floor((mouse_x_coordinate - OFFSET) / cell_size));
+            int cell_y_coordinate = static_cast<int>(std::floor((mouse_y_coordinate - OFFSET) / cell_size));
+            if (obstacles.InBounds(cell_x_coordinate, cell_y_coordinate)) {
                 if (last_x_coordinate == -1 || last_x_coordinate != cell_x_coordinate || last_y_coordinate != cell_y_coordinate) {
-                    obstacles[cell_x_coordinate][cell_y_coordinate] = Empty;
+                    obstacles(cell_x_coordinate, cell_y_coordinate) = Empty;
                     graph.ResetAlgorithm();
                     graph.setObstacles(obstacles);
+                    if (replanning) {
+                        planner.UpdateCell(cell_x_coordinate, cell_y_coordinate, Empty);
+                        replan();
+                    }
                     last_x_coordinate = cell_x_coordinate;
                     last_y_coordinate = cell_y_coordinate;
                 }
             }
         }
         // Starting an algorithm based on the algorithm picked
+        bool is_maze_picked = algoritm_picker == AlgorithmPicked::RandomMaze || algoritm_picker == AlgorithmPicked::RandomBacktrackerMaze;
         if (elapsed.asSeconds() >= step_interval && algoritm_picker != AlgorithmPicked::None) {
-            switch (algoritm_picker) {
-            case AlgorithmPicked::BFS:
-                graph.RunBFS();
-                break;
-            case AlgorithmPicked::DFS:
-                graph.RunDFS();
-                break;
-            case AlgorithmPicked::Dijkstra:
-                graph.RunDijkstra();
-                break;
-            case AlgorithmPicked::AStar:
-                graph.RunAStar();
-                break;
-            case AlgorithmPicked::GBFS:
-                graph.RunGBFS();
-                break;
-            case AlgorithmPicked::RandomMaze:
-                random_maze.GenerateRandomMaze();
-                break;
-            case AlgorithmPicked::RandomBacktrackerMaze:
-                random_maze.GenerateRecursiveBacktrackerMaze();
+            if (algoritm_picker == AlgorithmPicked::RandomMaze) {
+                for (long long step = 0; step < steps_per_tick && !random_maze.getFinished(); step++) {
+                    random_maze.GenerateRandomMaze();
+                }
+                obstacles = random_maze.getGrid();
             }
-            if (algoritm_picker == AlgorithmPicked::RandomMaze || algoritm_picker == AlgorithmPicked::RandomBacktrackerMaze) {
+            else if (algoritm_picker == AlgorithmPicked::RandomBacktrackerMaze) {
+                for (long long step = 0; step < steps_per_tick && !random_maze.getFinished(); step++) {
+                    random_maze.GenerateRecursiveBacktrackerMaze();
+                }
                 obstacles = random_maze.getGrid();
             }
             else {
-                obstacles = graph.getVertices();
+                graph.RunSteps(steps_per_tick, true); // The graph remembers the algorithm which was set up
             }
             timer.restart();
         }
 
         // Get the path from source to the ending node if the algorithm finished
         if (graph.getFinished()) {
-            obstacles = graph.TraceShortestPath();
+            obstacles = graph.getVertices(); // Keep the cells marked by the algorithm, the grid is only copied once per run
+            for (const sf::Vector2i& cell : graph.TraceShortestPath()) {
+                obstacles(cell.x, cell.y) = Route;
+            }
             algoritm_picker = AlgorithmPicked::None;
             graph.ResetAlgorithm();
         }
@@ -327,31 +517,17 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
             algoritm_picker = AlgorithmPicked::None;
         }
 
-        // Render the window
+        // Render the window, while a search runs the cells are read from the graph instead of copying them every step
+        const Grid<CellState>& shown = algoritm_picker != AlgorithmPicked::None && !is_maze_picked ? graph.getVertices() : obstacles;
         window.clear(sf::Color(0, 34, 77));
-        for (int i = 0; i < GRID_SIZE; ++i) {
-            for (int j = 0; j < GRID_SIZE; ++j) {
-                if (sf::Vector2i(i, j) == start) {
-                    grid[i][j].setFillColor(sf::Color(38, 186, 30));
-                }
-                else if (sf::Vector2i(i, j) == end) {
-                    grid[i][j].setFillColor(sf::Color::Red);
-                }
-                else if (obstacles[i][j] == Obstacle) {
-                    grid[i][j].setFillColor(sf::Color::Black); // Obstacle
-                }
-                else if (obstacles[i][j] == Empty) {
-                    grid[i][j].setFillColor(sf::Color::White); // Empty
-                }
-                else if (obstacles[i][j] == Route) {
-                    grid[i][j].setFillColor(sf::Color::Yellow);
-                }
-                else if (obstacles[i][j] == RouteHelper) {
-                    grid[i][j].setFillColor(sf::Color::Magenta);
-                }
-                window.draw(grid[i][j]);
-            }
+        for (size_t i = 0; i < shown.getSize(); ++i) {
+            SetPixel(pixels, i, cell_colors[shown[i]]);
         }
+        SetPixel(pixels, shown.Index(start.x, start.y), sf::Color(38, 186, 30));
+        SetPixel(pixels, shown.Index(end.x, end.y), sf::Color::Red);
+        grid_texture.update(pixels.data());
+        window.draw(grid_sprite);
+        window.draw(grid_lines);
         bfs_button.Draw(window);
         dfs_button.Draw(window);
         reset_button.Draw(window);
@@ -360,6 +536,13 @@ void UnweightedAlgorithmsPage::Display(sf::RenderWindow& window) {
         dijkstra_button.Draw(window);
         a_star_button.Draw(window);
         gbfs_button.Draw(window);
+        jps_button.Draw(window);
+        jps_plus_button.Draw(window);
+        bitboard_bfs_button.Draw(window);
+        bidirectional_bfs_button.Draw(window);
+        bidirectional_dijkstra_button.Draw(window);
+        bidirectional_a_star_button.Draw(window);
+        d_star_lite_button.Draw(window);
         window.display();
     }
 }
@@ -2,51 +2,99 @@
 #include <iostream>
 #include <cmath>
 #include <climits>
+#include <algorithm>
 
 #define NEIGHBOURS_COUNT 4 // The amount of neighbours a node has if we don't allow going trough a corncer of a node
+#define DIAGONAL_NEIGHBOURS_COUNT 8 // The amount of neighbours with the diagonal moves, the first four are the straight ones
+#define NO_DIRECTION 8 // The direction of a jump point which was not reached by a jump, the start
+#define STRAIGHT_COST 70 // Cost of a straight move of the 8-connected searches, a diagonal move costs 99/70, close to sqrt(2)
+#define DIAGONAL_COST 99
 
 // Constructor
-UnweightedGraph::UnweightedGraph(const std::vector<std::vector<CellState>>& vertices_of_the_graph, const sf::Vector2i& starting_point, const sf::Vector2i& ending_point) {
+UnweightedGraph::UnweightedGraph(const Grid<CellState>& vertices_of_the_graph, const sf::Vector2i& starting_point, const sf::Vector2i& ending_point) {
     finished = false;
+    expansions = 0;
     vertices = vertices_of_the_graph;
     start = starting_point; 
     end = ending_point;
-    row_size = vertices.size();
-    column_size = vertices[0].size();
-    vertices[end.x][end.y] = Empty;
-    distances.resize(vertices.size(), std::vector<int>(vertices.size(), INT_MAX)); // Initailize everything for INT_MAX to find the shortest possible path
-    visited.resize(vertices.size(), std::vector<bool>(vertices.size(), false));
-    distances[start.x][start.y] = 0;
+    vertices(end.x, end.y) = Empty;
+    distances.Resize(vertices.getWidth(), vertices.getHeight(), INT_MAX); // Initailize everything for INT_MAX to find the shortest possible path
+    visited.Resize(vertices.getWidth(), vertices.getHeight(), false);
+    parents.Resize(vertices.getWidth(), vertices.getHeight(), NO_DIRECTION);
+    jump_distances_ready = false;
+    best_meeting_length = INT_MAX;
+    algorithm = GridAlgorithm::None;
+    connectivity = Connectivity::Four;
+    corner_cutting = CornerCutting::Forbid;
+    straight_cost = 1;
+    landmarks = nullptr;
+    distances(start.x, start.y) = 0;
 }
 
 bool UnweightedGraph::CheckCellValidity(const int& row, const int& col) {
-    if (row < 0 || col < 0 || row >= row_size || col >= column_size) {
+    if (!vertices.InBounds(row, col)) {
         return false;
     }
-    if (visited[row][col] || vertices[row][col] == Obstacle) {
+    if (visited(row, col) || vertices(row, col) == Obstacle) {
         return false;
     }
     
     return true;
 }
 
-void UnweightedGraph::RunBFS() {
+bool UnweightedGraph::CanMoveDiagonally(const int& x, const int& y, const int& direction) const {
+    if (direction < NEIGHBOURS_COUNT || corner_cutting == CornerCutting::Allow) {
+        return true;
+    }
+    // The two straight neighbours the diagonal move passes between
+    bool horizontal_free = IsFree(x + row_adder[direction], y);
+    bool vertical_free = IsFree(x, y + col_adder[direction]);
+    if (corner_cutting == CornerCutting::Forbid) {
+        return horizontal_free && vertical_free;
+    }
+    return horizontal_free || vertical_free;
+}
+
+template<bool Diagonal>
+int UnweightedGraph::MoveCost(const int& direction) {
+    if (!Diagonal) {
+        return 1;
+    }
+    return direction < NEIGHBOURS_COUNT ? STRAIGHT_COST : DIAGONAL_COST;
+}
+
+template<bool Animate, bool Diagonal>
+void UnweightedGraph::StepBFS() {
     if (!bfs_queue.empty()) {
-        sf::Vector2i cell = bfs_queue.front();
-        int x = cell.x;
-        int y = cell.y;
-        vertices[x][y] = RouteHelper;
+        uint32_t cell = bfs_queue.front();
+        int x = vertices.CellX(cell);
+        int y = vertices.CellY(cell);
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
         bfs_queue.pop();
+        expansions++;
 
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        const int neighbours = Diagonal ? DIAGONAL_NEIGHBOURS_COUNT : NEIGHBOURS_COUNT;
+        for (int i = 0; i < neighbours; i++) {
 
             int adjx = x + row_adder[i];
             int adjy = y + col_adder[i];
+            if (Diagonal && !CanMoveDiagonally(x, y, i)) {
+                continue;
+            }
 
             if (CheckCellValidity(adjx, adjy)) {
-                distances[adjx][adjy] = distances[x][y] + 1;
-                bfs_queue.push({ adjx, adjy });
-                visited[adjx][adjy] = true;
+                distances(adjx, adjy) = distances(x, y) + MoveCost<Diagonal>(i);
+                parents(adjx, adjy) = i;
+                bfs_queue.push(vertices.Index(adjx, adjy));
+                visited(adjx, adjy) = true;
+
+                // The distance of a cell is final once Breadth First Search reaches it
+                if (adjx == end.x && adjy == end.y) {
+                    finished = true;
+                    return;
+                }
             }
         }
     }
@@ -55,23 +103,32 @@ void UnweightedGraph::RunBFS() {
     }
 }
 
-void UnweightedGraph::RunDFS() {
+template<bool Animate, bool Diagonal>
+void UnweightedGraph::StepDFS() {
     if (!dfs_stack.empty()) {
-        sf::Vector2i cell = dfs_stack.top();
-        int x = cell.x;
-        int y = cell.y;
-        vertices[x][y] = RouteHelper;
+        uint32_t cell = dfs_stack.top();
+        int x = vertices.CellX(cell);
+        int y = vertices.CellY(cell);
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
 
         dfs_stack.pop();
+        expansions++;
 
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        const int neighbours = Diagonal ? DIAGONAL_NEIGHBOURS_COUNT : NEIGHBOURS_COUNT;
+        for (int i = 0; i < neighbours; i++) {
             int adjx = x + row_adder[i];
             int adjy = y + col_adder[i];
+            if (Diagonal && !CanMoveDiagonally(x, y, i)) {
+                continue;
+            }
 
-            if (CheckCellValidity(adjx, adjy) && !visited[adjx][adjy]) {
-                distances[adjx][adjy] = distances[x][y] + 1;
-                dfs_stack.push({ adjx, adjy });
-                visited[adjx][adjy] = true;
+            if (CheckCellValidity(adjx, adjy) && !visited(adjx, adjy)) {
+                distances(adjx, adjy) = distances(x, y) + MoveCost<Diagonal>(i);
+                parents(adjx, adjy) = i;
+                dfs_stack.push(vertices.Index(adjx, adjy));
+                visited(adjx, adjy) = true;
             }
         }
     }
@@ -80,29 +137,43 @@ void UnweightedGraph::RunDFS() {
     }
 }
 
-void UnweightedGraph::RunDijkstra() {
+template<bool Animate, bool Diagonal>
+void UnweightedGraph::StepDijkstra() {
     if (!dijkstra_priority_queue.empty()) {
-        auto cell = dijkstra_priority_queue.top();
-        dijkstra_priority_queue.pop();
-        int x = cell.second.x;
-        int y = cell.second.y;
-        vertices[x][y] = RouteHelper;
-        int dist = cell.first;
-
-        if (distances[x][y] < dist) {
+        int dist = dijkstra_priority_queue.TopKey();
+        uint32_t cell = dijkstra_priority_queue.Top();
+        dijkstra_priority_queue.Pop();
+        int x = vertices.CellX(cell);
+        int y = vertices.CellY(cell);
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
+
+        if (distances(x, y) < dist) {
             return;
         }
 
-        visited[x][y] = true;
+        visited(x, y) = true;
+        expansions++;
 
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        if (x == end.x && y == end.y) {
+            finished = true;
+            return;
+        }
+
+        const int neighbours = Diagonal ? DIAGONAL_NEIGHBOURS_COUNT : NEIGHBOURS_COUNT;
+        for (int i = 0; i < neighbours; i++) {
             int adjx = x + row_adder[i];
             int adjy = y + col_adder[i];
-            int new_dist = dist + 1;
+            if (Diagonal && !CanMoveDiagonally(x, y, i)) {
+                continue;
+            }
+            int new_dist = dist + MoveCost<Diagonal>(i);
 
-            if (CheckCellValidity(adjx, adjy) && new_dist < distances[adjx][adjy]) {
-                distances[adjx][adjy] = new_dist;
-                dijkstra_priority_queue.push({ new_dist, sf::Vector2i(adjx, adjy) });
+            if (CheckCellValidity(adjx, adjy) && new_dist < distances(adjx, adjy)) {
+                distances(adjx, adjy) = new_dist;
+                parents(adjx, adjy) = i;
+                dijkstra_priority_queue.Push(new_dist, vertices.Index(adjx, adjy));
             }
         }
     }
@@ -111,64 +182,590 @@ void UnweightedGraph::RunDijkstra() {
     }
 }
 
-void UnweightedGraph::RunAStar() {
+template<bool Animate, bool Diagonal>
+void UnweightedGraph::StepAStar() {
     if (!astar_priority_queue.empty()) {
-        std::pair<float, sf::Vector2i> current = astar_priority_queue.top();
-        sf::Vector2i cell = current.second;
-        int x = cell.x;
-        int y = cell.y;
-        vertices[x][y] = RouteHelper;
-        astar_priority_queue.pop();
+        int key = astar_priority_queue.TopKey();
+        uint32_t cell = astar_priority_queue.Top();
+        int x = vertices.CellX(cell);
+        int y = vertices.CellY(cell);
+        astar_priority_queue.Pop();
+
+        // Skip the outdated entries, the cell was pushed again with a lower cost
+        if (key > distances(x, y) + heuristic.Estimate(x, y)) {
+            return;
+        }
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
+        visited(x, y) = true;
+        expansions++;
 
         if (x == end.x && y == end.y) {
             finished = true;
             return;
         }
 
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        const int neighbours = Diagonal ? DIAGONAL_NEIGHBOURS_COUNT : NEIGHBOURS_COUNT;
+        int estimates[DIAGONAL_NEIGHBOURS_COUNT];
+        heuristic.EstimateNeighbours(x, y, row_adder, col_adder, neighbours, estimates);
+        for (int i = 0; i < neighbours; i++) {
             int adjx = x + row_adder[i];
             int adjy = y + col_adder[i];
+            if (Diagonal && !CanMoveDiagonally(x, y, i)) {
+                continue;
+            }
 
             if (CheckCellValidity(adjx, adjy)) {
-                float new_cost = distances[x][y] + 1 + std::sqrt(std::pow(end.x - adjx, 2) + std::pow(end.y - adjy, 2)); // Heuristic cost
-                if (!visited[adjx][adjy] || new_cost < distances[adjx][adjy]) {
-                    distances[adjx][adjy] = new_cost;
-                    astar_priority_queue.push({ new_cost, sf::Vector2i(adjx, adjy)});
-                    visited[adjx][adjy] = true;
+                int new_distance = distances(x, y) + MoveCost<Diagonal>(i); // The distances keep the cost from the start, the heuristic is only added to the priority
+                if (new_distance < distances(adjx, adjy)) {
+                    distances(adjx, adjy) = new_distance;
+                    parents(adjx, adjy) = i;
+                    astar_priority_queue.Push(new_distance + estimates[i], vertices.Index(adjx, adjy));
                 }
             }
         }
     }
+    else {
+        finished = true;
+    }
 }
 
-void UnweightedGraph::RunGBFS() {
+template<bool Animate, bool Diagonal>
+void UnweightedGraph::StepGBFS() {
     if (!gbfs_priority_queue.empty()) {
-        std::pair<float, sf::Vector2i> current = gbfs_priority_queue.top();
-        sf::Vector2i cell = current.second;
-        int x = cell.x;
-        int y = cell.y;
-        vertices[x][y] = RouteHelper;
+        std::pair<int, uint32_t> current = gbfs_priority_queue.top();
+        int x = vertices.CellX(current.second);
+        int y = vertices.CellY(current.second);
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
         gbfs_priority_queue.pop();
+        expansions++;
 
         if (x == end.x && y == end.y) {
             finished = true;
             return;
         }
 
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        const int neighbours = Diagonal ? DIAGONAL_NEIGHBOURS_COUNT : NEIGHBOURS_COUNT;
+        int estimates[DIAGONAL_NEIGHBOURS_COUNT];
+        heuristic.EstimateNeighbours(x, y, row_adder, col_adder, neighbours, estimates);
+        for (int i = 0; i < neighbours; i++) {
             int adjx = x + row_adder[i];
             int adjy = y + col_adder[i];
+            if (Diagonal && !CanMoveDiagonally(x, y, i)) {
+                continue;
+            }
 
             if (CheckCellValidity(adjx, adjy)) {
-                float new_cost = std::sqrt(std::pow(end.x - adjx, 2) + std::pow(end.y - adjy, 2)); // Heuristic cost
-                if (!visited[adjx][adjy]) {
-                    gbfs_priority_queue.push({ new_cost, sf::Vector2i(adjx, adjy)});
-                    visited[adjx][adjy] = true;
-                    distances[adjx][adjy] = distances[x][y] + 1;
+                if (!visited(adjx, adjy)) {
+                    gbfs_priority_queue.push({ estimates[i], vertices.Index(adjx, adjy) });
+                    visited(adjx, adjy) = true;
+                    distances(adjx, adjy) = distances(x, y) + MoveCost<Diagonal>(i);
+                    parents(adjx, adjy) = i;
                 }
             }
         }
     }
+    else {
+        finished = true;
+    }
+}
+
+bool UnweightedGraph::IsFree(const int& x, const int& y) const {
+    return vertices.InBounds(x, y) && vertices(x, y) != Obstacle;
+}
+
+// Jump Point Search on the 4-connected grid. Paths are searched in the canonical form where a vertical move
+// is made as early as possible, so a horizontal jump only stops where a vertical move becomes possible that was
+// blocked one cell earlier (a forced neighbour). A vertical jump stops on every cell from which a horizontal
+// jump finds a jump point, the horizontal moves after a vertical one are never pruned.
+
+bool UnweightedGraph::HasForcedNeighbour(const int& x, const int& y, const int& dx) const {
+    return (IsFree(x, y - 1) && !IsFree(x - dx, y - 1)) || (IsFree(x, y + 1) && !IsFree(x - dx, y + 1));
+}
+
+template<bool Animate>
+sf::Vector2i UnweightedGraph::Jump(const int& x, const int& y, const int& direction) {
+    int dx = row_adder[direction];
+    int dy = col_adder[direction];
+    int current_x = x;
+    int current_y = y;
+    while (true) {
+        current_x += dx;
+        current_y += dy;
+        if (!IsFree(current_x, current_y)) {
+            return { -1, -1 };
+        }
+        if (Animate) {
+            vertices(current_x, current_y) = RouteHelper;
+        }
+
+        if (current_x == end.x && current_y == end.y) {
+            return { current_x, current_y };
+        }
+        if (dx != 0) {
+            if (HasForcedNeighbour(current_x, current_y, dx)) {
+                return { current_x, current_y };
+            }
+        }
+        else if (Jump<Animate>(current_x, current_y, 0).x != -1 || Jump<Animate>(current_x, current_y, 2).x != -1) {
+            return { current_x, current_y };
+        }
+    }
+}
+
+sf::Vector2i UnweightedGraph::JumpPlus(const int& x, const int& y, const int& direction) {
+    int dx = row_adder[direction];
+    int dy = col_adder[direction];
+    int distance = jump_distances(x, y)[direction];
+    int reach = std::abs(distance); // The number of free cells which would be scanned in this direction
+
+    if (dx != 0 && end.y == y) {
+        int steps = (end.x - x) * dx;
+        if (steps > 0 && steps <= reach) {
+            return end;
+        }
+    }
+    if (dy != 0) {
+        int steps = (end.y - y) * dy;
+        if (steps > 0 && steps <= reach) {
+            // The scan crosses the row of the end, stop there so the horizontal jumps can reach the end
+            return { x, end.y };
+        }
+    }
+    if (distance > 0) {
+        return { x + dx * distance, y + dy * distance };
+    }
+    return { -1, -1 };
+}
+
+void UnweightedGraph::ComputeJumpDistances() {
+    int width = vertices.getWidth();
+    int height = vertices.getHeight();
+    jump_distances.Resize(width, height, { 0, 0, 0, 0 });
+
+    // The horizontal directions first, the vertical jumps stop where a horizontal jump finds a jump point.
+    // Every line is swept against the direction, so the next cell is always computed before the current one.
+    for (int direction : { 0, 2 }) {
+        int dx = row_adder[direction];
+        for (int y = 0; y < height; y++) {
+            for (int i = 0; i < width; i++) {
+                int x = dx > 0 ? width - 1 - i : i;
+                int& distance = jump_distances(x, y)[direction];
+                if (!IsFree(x + dx, y)) {
+                    distance = 0;
+                }
+                else if (HasForcedNeighbour(x + dx, y, dx)) {
+                    distance = 1;
+                }
+                else {
+                    int next = jump_distances(x + dx, y)[direction];
+                    distance = next > 0 ? next + 1 : next - 1;
+                }
+            }
+        }
+    }
+    for (int direction : { 1, 3 }) {
+        int dy = col_adder[direction];
+        for (int i = 0; i < height; i++) {
+            int y = dy > 0 ? height - 1 - i : i;
+            for (int x = 0; x < width; x++) {
+                int& distance = jump_distances(x, y)[direction];
+                if (!IsFree(x, y + dy)) {
+                    distance = 0;
+                }
+                else if (jump_distances(x, y + dy)[0] > 0 || jump_distances(x, y + dy)[2] > 0) {
+                    distance = 1;
+                }
+                else {
+                    int next = jump_distances(x, y + dy)[direction];
+                    distance = next > 0 ? next + 1 : next - 1;
+                }
+            }
+        }
+    }
+    jump_distances_ready = true;
+}
+
+template<bool Animate>
+void UnweightedGraph::StepJumpPointSearch(const bool& use_jump_distances) {
+    if (jps_priority_queue.empty()) {
+        finished = true;
+        return;
+    }
+    std::pair<int, uint32_t> current = jps_priority_queue.top();
+    int x = vertices.CellX(current.second);
+    int y = vertices.CellY(current.second);
+    jps_priority_queue.pop();
+
+    // Skip the outdated entries, the jump point was pushed again with a lower cost
+    if (current.first > distances(x, y) + heuristic.Estimate(x, y)) {
+        return;
+    }
+    if (Animate) {
+        vertices(x, y) = RouteHelper;
+    }
+    visited(x, y) = true;
+    expansions++;
+
+    if (x == end.x && y == end.y) {
+        FinishJumpPointSearch();
+        finished = true;
+        return;
+    }
+
+    int from = parents(x, y);
+    for (int direction = 0; direction < NEIGHBOURS_COUNT; direction++) {
+        if (from != NO_DIRECTION) {
+            if (direction == (from + 2) % NEIGHBOURS_COUNT) {
+                continue;
+            }
+            // After a horizontal move only the forced vertical neighbours are searched
+            int dx = row_adder[from];
+            int dy = col_adder[direction];
+            if (dx != 0 && direction != from && !(IsFree(x, y + dy) && !IsFree(x - dx, y + dy))) {
+                continue;
+            }
+        }
+
+        sf::Vector2i jump_point = use_jump_distances ? JumpPlus(x, y, direction) : Jump<Animate>(x, y, direction);
+        if (jump_point.x == -1) {
+            continue;
+        }
+        int new_distance = distances(x, y) + std::abs(jump_point.x - x) + std::abs(jump_point.y - y);
+        if (new_distance < distances(jump_point.x, jump_point.y)) {
+            distances(jump_point.x, jump_point.y) = new_distance;
+            parents(jump_point.x, jump_point.y) = direction;
+            jps_priority_queue.push({ new_distance + heuristic.Estimate(jump_point.x, jump_point.y), vertices.Index(jump_point.x, jump_point.y) });
+        }
+    }
+}
+
+void UnweightedGraph::FinishJumpPointSearch() {
+    // Walk back from the end, every jump is followed backwards until an expanded jump point which is exactly
+    // as far from the start as the jump is long, the cells skipped by the jump get the direction of the jump
+    int x = end.x;
+    int y = end.y;
+    while (x != start.x || y != start.y) {
+        int direction = parents(x, y);
+        int distance = distances(x, y);
+        int steps = 0;
+        while (true) {
+            x -= row_adder[direction];
+            y -= col_adder[direction];
+            steps++;
+            if (visited(x, y) && distances(x, y) + steps == distance) {
+                break;
+            }
+            parents(x, y) = direction;
+        }
+    }
+}
+
+template<bool Animate>
+void UnweightedGraph::StepBitboardBFS() {
+    if (bitboard_bfs.Step() == 0) {
+        finished = true;
+        return;
+    }
+    int depth = bitboard_bfs.getDepth();
+    bitboard_bfs.ForEachFrontierCell([&](const int& x, const int& y) {
+        distances(x, y) = depth;
+        visited(x, y) = true;
+        if (Animate) {
+            vertices(x, y) = RouteHelper;
+        }
+        expansions++;
+    });
+    if (visited(end.x, end.y)) {
+        finished = true;
+
+        // The wavefronts only give the distances, the parents of the path are found by stepping down the distances from the end
+        sf::Vector2i cell = end;
+        while (cell != start) {
+            for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+                int adjx = cell.x - row_adder[i];
+                int adjy = cell.y - col_adder[i];
+                if (vertices.InBounds(adjx, adjy) && distances(adjx, adjy) == distances(cell.x, cell.y) - 1) {
+                    parents(cell.x, cell.y) = i;
+                    cell = { adjx, adjy };
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Bidirectional searches. Both searches keep their own distances, every edge between a cell of one search and
+// a cell reached by the other one closes a path from the start to the end, the shortest of them is remembered.
+// The searches stop once no path through the unexpanded cells can be shorter than the remembered one.
+
+void UnweightedGraph::UpdateMeetingPoint(const bool& forward, const sf::Vector2i& cell, const sf::Vector2i& neighbour, const int& length) {
+    if (length < best_meeting_length) {
+        best_meeting_length = length;
+        meeting_forward = forward ? cell : neighbour;
+        meeting_backward = forward ? neighbour : cell;
+    }
+}
+
+template<bool Animate>
+void UnweightedGraph::StepBidirectionalBFS() {
+    // The fronts of the queues have the smallest distances of the two searches
+    if (bfs_queue.empty() || backward_bfs_queue.empty()
+        || distances[bfs_queue.front()] + backward_distances[backward_bfs_queue.front()] >= best_meeting_length) {
+        FinishBidirectionalSearch();
+        return;
+    }
+
+    // Expand the smaller frontier, so the two searches stay about the same size
+    bool forward = bfs_queue.size() <= backward_bfs_queue.size();
+    std::queue<uint32_t>& queue = forward ? bfs_queue : backward_bfs_queue;
+    Grid<int>& own_distances = forward ? distances : backward_distances;
+    Grid<unsigned char>& own_visited = forward ? visited : backward_visited;
+    Grid<unsigned char>& own_parents = forward ? parents : backward_parents;
+    const Grid<int>& other_distances = forward ? backward_distances : distances;
+
+    sf::Vector2i cell(vertices.CellX(queue.front()), vertices.CellY(queue.front()));
+    queue.pop();
+    if (Animate) {
+        vertices(cell.x, cell.y) = RouteHelper;
+    }
+    expansions++;
+
+    for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        int adjx = cell.x + row_adder[i];
+        int adjy = cell.y + col_adder[i];
+        if (!IsFree(adjx, adjy)) {
+            continue;
+        }
+        if (other_distances(adjx, adjy) != INT_MAX) {
+            UpdateMeetingPoint(forward, cell, { adjx, adjy }, own_distances(cell.x, cell.y) + 1 + other_distances(adjx, adjy));
+        }
+        if (!own_visited(adjx, adjy)) {
+            own_visited(adjx, adjy) = true;
+            own_distances(adjx, adjy) = own_distances(cell.x, cell.y) + 1;
+            own_parents(adjx, adjy) = i;
+            queue.push(vertices.Index(adjx, adjy));
+        }
+    }
+}
+
+template<bool Animate>
+void UnweightedGraph::StepBidirectionalBestFirst(const bool& use_heuristic) {
+    // Dijkstra can stop once the two smallest distances together reach the best path. The heuristics of A* are consistent,
+    // so A* can stop once the smallest estimate of either search reaches it.
+    bool done = forward_priority_queue.empty() || backward_priority_queue.empty();
+    if (!done) {
+        int forward_key = forward_priority_queue.TopKey();
+        int backward_key = backward_priority_queue.TopKey();
+        done = use_heuristic ? std::max(forward_key, backward_key) >= best_meeting_length : forward_key + backward_key >= best_meeting_length;
+    }
+    if (done) {
+        FinishBidirectionalSearch();
+        return;
+    }
+
+    // Expand the smaller frontier, the forward search is guided to the end, the backward search to the start
+    bool forward = forward_priority_queue.size() <= backward_priority_queue.size();
+    auto& queue = forward ? forward_priority_queue : backward_priority_queue;
+    Grid<int>& own_distances = forward ? distances : backward_distances;
+    Grid<unsigned char>& own_visited = forward ? visited : backward_visited;
+    Grid<unsigned char>& own_parents = forward ? parents : backward_parents;
+    const Grid<int>& other_distances = forward ? backward_distances : distances;
+    const Heuristic& own_heuristic = forward ? heuristic : backward_heuristic;
+
+    int key = queue.TopKey();
+    uint32_t cell = queue.Top();
+    queue.Pop();
+    int x = vertices.CellX(cell);
+    int y = vertices.CellY(cell);
+    int distance = own_distances(x, y);
+
+    // Skip the outdated entries, the cell was pushed again with a lower cost
+    if (own_visited(x, y) || key > distance + (use_heuristic ? own_heuristic.Estimate(x, y) : 0)) {
+        return;
+    }
+    if (Animate) {
+        vertices(x, y) = RouteHelper;
+    }
+    own_visited(x, y) = true;
+    expansions++;
+
+    int estimates[NEIGHBOURS_COUNT] = {};
+    if (use_heuristic) {
+        own_heuristic.EstimateNeighbours(x, y, row_adder, col_adder, NEIGHBOURS_COUNT, estimates);
+    }
+    for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
+        int adjx = x + row_adder[i];
+        int adjy = y + col_adder[i];
+        if (!IsFree(adjx, adjy)) {
+            continue;
+        }
+        int new_distance = distance + 1;
+        if (other_distances(adjx, adjy) != INT_MAX) {
+            UpdateMeetingPoint(forward, { x, y }, { adjx, adjy }, new_distance + other_distances(adjx, adjy));
+        }
+        if (!own_visited(adjx, adjy) && new_distance < own_distances(adjx, adjy)) {
+            own_distances(adjx, adjy) = new_distance;
+            own_parents(adjx, adjy) = i;
+            queue.Push(new_distance + estimates[i], vertices.Index(adjx, adjy));
+        }
+    }
+}
+
+void UnweightedGraph::FinishBidirectionalSearch() {
+    finished = true;
+    if (best_meeting_length == INT_MAX) {
+        return;
+    }
+
+    // The forward parents already lead from meeting_forward back to the start. The backward half is turned around,
+    // so the parents lead from the end back to meeting_forward too.
+    sf::Vector2i cell = meeting_forward;
+    sf::Vector2i next = meeting_backward;
+    while (cell != end) {
+        int direction = 0;
+        while (cell.x + row_adder[direction] != next.x || cell.y + col_adder[direction] != next.y) {
+            direction++;
+        }
+        parents(next.x, next.y) = direction;
+        distances(next.x, next.y) = distances(cell.x, cell.y) + 1;
+        cell = next;
+        if (cell != end) {
+            int backward_direction = backward_parents(cell.x, cell.y);
+            next = { cell.x - row_adder[backward_direction], cell.y - col_adder[backward_direction] };
+        }
+    }
+    visited(end.x, end.y) = true;
+}
+
+// The public single steps are used by the animated page, they mark the expanded cells as helpers on the grid.
+// RunSteps picks the algorithm once and then calls its step in a tight loop.
+
+void UnweightedGraph::RunBFS() {
+    if (connectivity == Connectivity::Eight) {
+        StepBFS<true, true>();
+    }
+    else {
+        StepBFS<true, false>();
+    }
+}
+
+void UnweightedGraph::RunDFS() {
+    if (connectivity == Connectivity::Eight) {
+        StepDFS<true, true>();
+    }
+    else {
+        StepDFS<true, false>();
+    }
+}
+
+void UnweightedGraph::RunDijkstra() {
+    if (connectivity == Connectivity::Eight) {
+        StepDijkstra<true, true>();
+    }
+    else {
+        StepDijkstra<true, false>();
+    }
+}
+
+void UnweightedGraph::RunAStar() {
+    if (connectivity == Connectivity::Eight) {
+        StepAStar<true, true>();
+    }
+    else {
+        StepAStar<true, false>();
+    }
+}
+
+void UnweightedGraph::RunGBFS() {
+    if (connectivity == Connectivity::Eight) {
+        StepGBFS<true, true>();
+    }
+    else {
+        StepGBFS<true, false>();
+    }
+}
+
+void UnweightedGraph::RunJPS() {
+    StepJumpPointSearch<true>(false);
+}
+
+void UnweightedGraph::RunJPSPlus() {
+    StepJumpPointSearch<true>(true);
+}
+
+void UnweightedGraph::RunBitboardBFS() {
+    StepBitboardBFS<true>();
+}
+
+void UnweightedGraph::RunBidirectionalBFS() {
+    StepBidirectionalBFS<true>();
+}
+
+void UnweightedGraph::RunBidirectionalDijkstra() {
+    StepBidirectionalBestFirst<true>(false);
+}
+
+void UnweightedGraph::RunBidirectionalAStar() {
+    StepBidirectionalBestFirst<true>(true);
+}
+
+template<bool Animate, bool Diagonal>
+long long UnweightedGraph::RunStepsOf(const long long& steps) {
+    long long done = 0;
+    switch (algorithm) {
+    case GridAlgorithm::BFS:
+        for (; done < steps && !finished; done++) StepBFS<Animate, Diagonal>();
+        break;
+    case GridAlgorithm::DFS:
+        for (; done < steps && !finished; done++) StepDFS<Animate, Diagonal>();
+        break;
+    case GridAlgorithm::Dijkstra:
+        for (; done < steps && !finished; done++) StepDijkstra<Animate, Diagonal>();
+        break;
+    case GridAlgorithm::AStar:
+        for (; done < steps && !finished; done++) StepAStar<Animate, Diagonal>();
+        break;
+    case GridAlgorithm::GBFS:
+        for (; done < steps && !finished; done++) StepGBFS<Animate, Diagonal>();
+        break;
+    case GridAlgorithm::JPS:
+        for (; done < steps && !finished; done++) StepJumpPointSearch<Animate>(false);
+        break;
+    case GridAlgorithm::JPSPlus:
+        for (; done < steps && !finished; done++) StepJumpPointSearch<Animate>(true);
+        break;
+    case GridAlgorithm::BitboardBFS:
+        for (; done < steps && !finished; done++) StepBitboardBFS<Animate>();
+        break;
+    case GridAlgorithm::BidirectionalBFS:
+        for (; done < steps && !finished; done++) StepBidirectionalBFS<Animate>();
+        break;
+    case GridAlgorithm::BidirectionalDijkstra:
+        for (; done < steps && !finished; done++) StepBidirectionalBestFirst<Animate>(false);
+        break;
+    case GridAlgorithm::BidirectionalAStar:
+        for (; done < steps && !finished; done++) StepBidirectionalBestFirst<Animate>(true);
+        break;
+    case GridAlgorithm::None:
+        break;
+    }
+    return done;
+}
+
+long long UnweightedGraph::RunSteps(const long long& steps, const bool& animate) {
+    // Every connectivity has its own compiled steps, the 4-connected ones do not check the diagonal moves at all
+    if (connectivity == Connectivity::Eight) {
+        return animate ? RunStepsOf<true, true>(steps) : RunStepsOf<false, true>(steps);
+    }
+    return animate ? RunStepsOf<true, false>(steps) : RunStepsOf<false, false>(steps);
+}
+
+long long UnweightedGraph::RunToCompletion() {
+    return RunSteps(LLONG_MAX, false);
 }
 
 
@@ -180,41 +777,67 @@ void UnweightedGraph::setEnd(const sf::Vector2i& ending_point) {
     end = ending_point;
 }
 
-void UnweightedGraph::setObstacles(const std::vector<std::vector<CellState>>& obstacles) {
-    vertices = obstacles;
+void UnweightedGraph::setConnectivity(const Connectivity& moves, const CornerCutting& corners) {
+    connectivity = moves;
+    corner_cutting = corners;
+    ResetAlgorithm();
 }
 
-std::vector<std::vector<CellState>> UnweightedGraph::TraceShortestPath() {
-    if (!visited[end.x][end.y]) {
-        std::cout << "No path found!" << std::endl;
-        return vertices;
-    }
+Connectivity UnweightedGraph::getConnectivity() const {
+    return connectivity;
+}
 
-    int x = end.x, y = end.y;
-    while (x != start.x || y != start.y) { 
-        vertices[x][y] = Route;
-        int minimal_distance = INT_MAX;
-        int next_x = -1;
-        int next_y = -1;
-        for (int i = 0; i < NEIGHBOURS_COUNT; i++) {
-            int adjx = x + row_adder[i];
-            int adjy = y + col_adder[i];
+CornerCutting UnweightedGraph::getCornerCutting() const {
+    return corner_cutting;
+}
 
-            if (adjx >= 0 && adjx < row_size && adjy >= 0 && adjy < column_size) {
-                if (distances[adjx][adjy] < minimal_distance) {
-                    minimal_distance = distances[adjx][adjy];
-                    next_x = adjx;
-                    next_y = adjy;
-                }
-            }
+int UnweightedGraph::getStraightCost() const {
+    return straight_cost;
+}
+
+void UnweightedGraph::setObstacles(const Grid<CellState>& obstacles) {
+    if (obstacles.getWidth() != vertices.getWidth() || obstacles.getHeight() != vertices.getHeight()) {
+        distances.Resize(obstacles.getWidth(), obstacles.getHeight(), INT_MAX);
+        visited.Resize(obstacles.getWidth(), obstacles.getHeight(), false);
+        parents.Resize(obstacles.getWidth(), obstacles.getHeight(), NO_DIRECTION);
+    }
+    // The jump distances only depend on the obstacles, so they are kept if the new grid blocks the same cells. The searches never
+    // add or remove an obstacle, the current grid still blocks the cells the table was computed for
+    if (jump_distances_ready) {
+        bool resized = obstacles.getWidth() != vertices.getWidth() || obstacles.getHeight() != vertices.getHeight();
+        bool changed = false;
+        for (size_t i = 0; !resized && i < obstacles.getSize(); i++) {
+            changed |= (obstacles[i] == Obstacle) != (vertices[i] == Obstacle);
         }
-        x = next_x;
-        y = next_y;
+        jump_distances_ready = !resized && !changed;
     }
-    return vertices;
+    vertices = obstacles;
+}
+
+void UnweightedGraph::setLandmarks(const Landmarks* landmarks) {
+    this->landmarks = landmarks; // Taken by the heuristics when the next search is set up
+}
+
+std::vector<sf::Vector2i> UnweightedGraph::TraceShortestPath() const {
+    std::vector<sf::Vector2i> path;
+    if (distances(end.x, end.y) == INT_MAX) {
+        std::cerr << "No path found!" << std::endl;
+        return path;
+    }
+
+    sf::Vector2i cell = end;
+    path.push_back(cell);
+    while (cell != start && parents(cell.x, cell.y) != NO_DIRECTION) {
+        int direction = parents(cell.x, cell.y);
+        cell.x -= row_adder[direction];
+        cell.y -= col_adder[direction];
+        path.push_back(cell);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
-std::vector<std::vector<CellState>> UnweightedGraph::getVertices() {
+const Grid<CellState>& UnweightedGraph::getVertices() const {
     return vertices;
 }
 
@@ -222,14 +845,56 @@ bool UnweightedGraph::getFinished() {
     return finished;
 }
 
+int UnweightedGraph::getDistance(const sf::Vector2i& cell) const {
+    return distances(cell.x, cell.y);
+}
+
+long long UnweightedGraph::getExpansions() const {
+    return expansions;
+}
+
+size_t UnweightedGraph::getMemoryUsage() const {
+    // Only the buffers kept for every cell, the queues grow with the frontier of the current search
+    return vertices.getSize() * sizeof(CellState)
+        + (distances.getSize() + backward_distances.getSize()) * sizeof(int)
+        + visited.getSize() + backward_visited.getSize() + parents.getSize() + backward_parents.getSize()
+        + jump_distances.getSize() * sizeof(std::array<int, 4>)
+        + bitboard_bfs.getMemoryUsage();
+}
+
 // Mainly for resetting the grid, to the previous colors (white)
 void UnweightedGraph::ResetAlgorithm() {
     finished = false;
-    distances.assign(vertices.size(), std::vector<int>(vertices.size(), INT_MAX));
-    visited.assign(vertices.size(), std::vector<bool>(vertices.size(), false));
-    distances[start.x][start.y] = 0;
-    vertices[end.x][end.y] = Empty;
-    visited[start.x][start.y] = true;
+    expansions = 0;
+    distances.Fill(INT_MAX);
+    visited.Fill(false);
+    parents.Fill(NO_DIRECTION);
+    distances(start.x, start.y) = 0;
+    if (vertices(end.x, end.y) == Obstacle) {
+        jump_distances_ready = false; // The end is cleared below, the jump distances have to see the free cell
+    }
+    vertices(end.x, end.y) = Empty;
+    visited(start.x, start.y) = true;
+    SetUpHeuristics(connectivity);
+    algorithm = GridAlgorithm::None;
+}
+
+void UnweightedGraph::SetUpHeuristics(const Connectivity& moves) {
+    if (moves == Connectivity::Eight) {
+        heuristic = Heuristic(HeuristicType::Octile, STRAIGHT_COST, DIAGONAL_COST);
+        straight_cost = STRAIGHT_COST;
+    }
+    else {
+        heuristic = Heuristic(HeuristicType::Manhattan, 1);
+        straight_cost = 1;
+    }
+    // Only tables of a grid of the same size and row length can be indexed by the cells, the heuristic ignores them with the diagonal moves
+    if (landmarks != nullptr && landmarks->getVertexCount() == vertices.getSize() && landmarks->getWidth() == static_cast<uint32_t>(vertices.getStride())) {
+        heuristic.setLandmarks(landmarks, vertices.getStride());
+    }
+    backward_heuristic = heuristic;
+    heuristic.setTarget(end);
+    backward_heuristic.setTarget(start);
 }
 
 void UnweightedGraph::SetUpBFS() {
@@ -237,7 +902,8 @@ void UnweightedGraph::SetUpBFS() {
     while (!bfs_queue.empty()) {
         bfs_queue.pop();
     }
-    bfs_queue.push({ start.x, start.y });
+    bfs_queue.push(vertices.Index(start.x, start.y));
+    algorithm = GridAlgorithm::BFS;
 }
 
 void UnweightedGraph::SetUpDFS() {
@@ -245,24 +911,22 @@ void UnweightedGraph::SetUpDFS() {
     while (!dfs_stack.empty()) {
         dfs_stack.pop();
     }
-    dfs_stack.push({ start.x, start.y });
+    dfs_stack.push(vertices.Index(start.x, start.y));
+    algorithm = GridAlgorithm::DFS;
 }
 
 void UnweightedGraph::SetUpDijkstra() {
     ResetAlgorithm();
-    while (!dijkstra_priority_queue.empty()) {
-        dijkstra_priority_queue.pop();
-    }
-    dijkstra_priority_queue.push({ 0, start });
+    dijkstra_priority_queue.Clear();
+    dijkstra_priority_queue.Push(0, vertices.Index(start.x, start.y));
+    algorithm = GridAlgorithm::Dijkstra;
 }
 
 void UnweightedGraph::SetUpAStar() {
     ResetAlgorithm();
-    while (!astar_priority_queue.empty()) {
-        astar_priority_queue.pop();
-    }
-    float initial_cost = std::sqrt(std::pow(end.x - start.x, 2) + std::pow(end.y - start.y, 2));
-    astar_priority_queue.push({ initial_cost, { start.x, start.y } });
+    astar_priority_queue.Clear();
+    astar_priority_queue.Push(heuristic.Estimate(start.x, start.y), vertices.Index(start.x, start.y));
+    algorithm = GridAlgorithm::AStar;
 }
 
 void UnweightedGraph::SetUpGBFS() {
@@ -270,6 +934,86 @@ void UnweightedGraph::SetUpGBFS() {
     while (!gbfs_priority_queue.empty()) {
         gbfs_priority_queue.pop();
     }
-    float initial_cost = std::sqrt(std::pow(end.x - start.x, 2) + std::pow(end.y - start.y, 2));
-    gbfs_priority_queue.push({ initial_cost, { start.x, start.y } });
+    gbfs_priority_queue.push({ heuristic.Estimate(start.x, start.y), vertices.Index(start.x, start.y) });
+    algorithm = GridAlgorithm::GBFS;
+}
+
+void UnweightedGraph::SetUpJPS() {
+    ResetAlgorithm();
+    SetUpHeuristics(Connectivity::Four); // The jumps only follow the straight moves
+    while (!jps_priority_queue.empty()) {
+        jps_priority_queue.pop();
+    }
+    jps_priority_queue.push({ heuristic.Estimate(start.x, start.y), vertices.Index(start.x, start.y) });
+    algorithm = GridAlgorithm::JPS;
+}
+
+void UnweightedGraph::SetUpJPSPlus() {
+    SetUpJPS();
+    if (!jump_distances_ready) {
+        ComputeJumpDistances();
+    }
+    algorithm = GridAlgorithm::JPSPlus;
+}
+
+void UnweightedGraph::SetUpBitboardBFS() {
+    ResetAlgorithm();
+    bitboard_bfs.setObstacles(vertices);
+    bitboard_bfs.Start(start);
+    vertices(start.x, start.y) = RouteHelper;
+    expansions = 1;
+    algorithm = GridAlgorithm::BitboardBFS;
+}
+
+void UnweightedGraph::SetUpBidirectional(const bool& closed_on_pop) {
+    ResetAlgorithm();
+    SetUpHeuristics(Connectivity::Four); // The bidirectional searches only use the straight moves
+    if (backward_distances.getWidth() != vertices.getWidth() || backward_distances.getHeight() != vertices.getHeight()) {
+        // The grids of the backward search are only allocated once a bidirectional search is used
+        backward_distances.Resize(vertices.getWidth(), vertices.getHeight(), INT_MAX);
+        backward_visited.Resize(vertices.getWidth(), vertices.getHeight(), false);
+        backward_parents.Resize(vertices.getWidth(), vertices.getHeight(), NO_DIRECTION);
+    }
+    else {
+        backward_distances.Fill(INT_MAX);
+        backward_visited.Fill(false);
+    }
+    backward_distances(end.x, end.y) = 0;
+    visited(start.x, start.y) = !closed_on_pop;
+    backward_visited(end.x, end.y) = !closed_on_pop;
+
+    best_meeting_length = INT_MAX;
+    if (start == end) {
+        UpdateMeetingPoint(true, start, end, 0);
+    }
+
+    while (!bfs_queue.empty()) {
+        bfs_queue.pop();
+    }
+    while (!backward_bfs_queue.empty()) {
+        backward_bfs_queue.pop();
+    }
+    forward_priority_queue.Clear();
+    backward_priority_queue.Clear();
+}
+
+void UnweightedGraph::SetUpBidirectionalBFS() {
+    SetUpBidirectional(false);
+    bfs_queue.push(vertices.Index(start.x, start.y));
+    backward_bfs_queue.push(vertices.Index(end.x, end.y));
+    algorithm = GridAlgorithm::BidirectionalBFS;
+}
+
+void UnweightedGraph::SetUpBidirectionalDijkstra() {
+    SetUpBidirectional(true);
+    forward_priority_queue.Push(0, vertices.Index(start.x, start.y));
+    backward_priority_queue.Push(0, vertices.Index(end.x, end.y));
+    algorithm = GridAlgorithm::BidirectionalDijkstra;
+}
+
+void UnweightedGraph::SetUpBidirectionalAStar() {
+    SetUpBidirectional(true);
+    forward_priority_queue.Push(heuristic.Estimate(start.x, start.y), vertices.Index(start.x, start.y));
+    backward_priority_queue.Push(backward_heuristic.Estimate(end.x, end.y), vertices.Index(end.x, end.y));
+    algorithm = GridAlgorithm::BidirectionalAStar;
 }
\ No newline at end of file
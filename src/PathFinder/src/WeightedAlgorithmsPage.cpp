@@ -1,5 +1,6 @@
 #include "../headers/WeightedAlgorithmsPage.hpp"
 #include "../headers/WeightedGraph.hpp"
+#include "../headers/WeightedGraphView.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
@@ -12,7 +13,8 @@ enum class AlgorithmPicked { // Enum for the algorithms, to see which one is pic
     Dijkstra,
     BFS,
     Bellman_Ford,
-    DFS
+    DFS,
+    SPFA
 };
 
 float CalculateAngle(const sf::Vector2f& start, const sf::Vector2f& end) {
@@ -89,6 +91,7 @@ void WeightedPage::Display(sf::RenderWindow& window) {
     const float step_interval = 1.0f; // The step interval for the timer
 
     WeightedGraph graph;
+    WeightedGraphView view; // The graphics of the graph, colored by the events of the animated steps
 
     // The frame of the graphs where the user can draw circles
     sf::RectangleShape graph_frame;
@@ -106,9 +109,9 @@ void WeightedPage::Display(sf::RenderWindow& window) {
 	}
 
     // Set up for the buttons
-    Button reset_button("Reset graph", { 300, 100 }, sf::Color(255, 32, 78), sf::Color::White);
+    Button reset_button("Reset graph", { 300, 80 }, sf::Color(255, 32, 78), sf::Color::White);
     reset_button.setFont(font);
-    reset_button.setPosition({ 350, 800 });
+    reset_button.setPosition({ 550, 790 });
     reset_button.setHoverColor(sf::Color(158, 28, 33));
 
     Button dijkstra_button("Dijkstra", { 300, 80 }, sf::Color(255, 32, 78), sf::Color::White);
@@ -131,6 +134,11 @@ void WeightedPage::Display(sf::RenderWindow& window) {
     bellman_ford_button.setFont(font);
     bellman_ford_button.setPosition({ 550, 670 });
 
+    Button spfa_button("SPFA", { 300, 80 }, sf::Color(255, 32, 78), sf::Color::White);
+    spfa_button.setHoverColor(sf::Color(160, 21, 62));
+    spfa_button.setFont(font);
+    spfa_button.setPosition({ 150, 790 });
+
 
     while (window.isOpen()) {
         sf::Time elapsed = timer.getElapsedTime();
@@ -141,6 +149,7 @@ void WeightedPage::Display(sf::RenderWindow& window) {
             else if (reset_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     graph.Clear();
+                    view.Clear();
                     selected_vertex = -1;
                     algorithm_picker = AlgorithmPicked::None;
                 }
@@ -148,52 +157,64 @@ void WeightedPage::Display(sf::RenderWindow& window) {
             else if (dijkstra_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     graph.SetUpDijkstra();
+                    view.ResetColors();
                     algorithm_picker = AlgorithmPicked::Dijkstra;
                 }
             }
             else if (bfs_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     graph.SetUpBFS();
+                    view.ResetColors();
                     algorithm_picker = AlgorithmPicked::BFS;
                 }
             }
             else if (dfs_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     graph.SetUpDFS();
+                    view.ResetColors();
                     algorithm_picker = AlgorithmPicked::DFS;
                 }
             }
             else if (bellman_ford_button.MouseOver(window)) {
                 if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                     graph.SetUpBellmanFord();
+                    view.ResetColors();
                     algorithm_picker = AlgorithmPicked::Bellman_Ford;
                 }
             }
+            else if (spfa_button.MouseOver(window)) {
+                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                    graph.SetUpSPFA();
+                    view.ResetColors();
+                    algorithm_picker = AlgorithmPicked::SPFA;
+                }
+            }
             else if (event.type == sf::Event::MouseButtonPressed) {
                 if (event.mouseButton.button == sf::Mouse::Left) {
                     sf::Vector2i position = sf::Mouse::getPosition(window);
                     bool vertex_clicked = false;
-                    for (int i = 0; i < graph.getVertices().size(); ++i) {
-                        if (graph.getVertices()[i].getGlobalBounds().contains(position.x, position.y)) {
+                    for (int i = 0; i < view.getVertices().size(); ++i) {
+                        if (view.getVertices()[i].getGlobalBounds().contains(position.x, position.y)) {
                             graph.Reset();
+                            view.ResetColors();
                             vertex_clicked = true;
                             if (selected_vertex == -1) {
                                 // If currently we don't have a selected vertex
-                                graph.ChangeVertexColor(sf::Color::Cyan, i);
+                                view.ChangeVertexColor(sf::Color::Cyan, i);
                                 selected_vertex = i;
                             }
                             else {
                                 // Else make an edge between the selected vertices
                                 int weight = getEdgeWeight(window);
                                 sf::VertexArray edge(sf::LinesStrip, 3);
-                                edge[0].position = graph.getVertices()[selected_vertex].getPosition() + sf::Vector2f(vertex_size, vertex_size);
-                                edge[1].position = graph.getVertices()[i].getPosition() + sf::Vector2f(vertex_size, vertex_size);
-                                edge[2].position = graph.getVertices()[selected_vertex].getPosition() + sf::Vector2f(vertex_size, vertex_size);
+                                edge[0].position = view.getVertices()[selected_vertex].getPosition() + sf::Vector2f(vertex_size, vertex_size);
+                                edge[1].position = view.getVertices()[i].getPosition() + sf::Vector2f(vertex_size, vertex_size);
+                                edge[2].position = view.getVertices()[selected_vertex].getPosition() + sf::Vector2f(vertex_size, vertex_size);
                                 edge[0].color = sf::Color::Black;
                                 edge[1].color = sf::Color::Black;
                                 edge[2].color = sf::Color::Black;
 
-                                float angle = CalculateAngle(graph.getVertices()[selected_vertex].getPosition() + sf::Vector2f(30, 30), graph.getVertices()[i].getPosition() + sf::Vector2f(30, 30));
+                                float angle = CalculateAngle(view.getVertices()[selected_vertex].getPosition() + sf::Vector2f(30, 30), view.getVertices()[i].getPosition() + sf::Vector2f(30, 30));
 
                                 // The edge weight
                                 sf::Text weight_text;
@@ -201,7 +222,7 @@ void WeightedPage::Display(sf::RenderWindow& window) {
                                 weight_text.setCharacterSize(20);
                                 weight_text.setFillColor(sf::Color::Black);
                                 weight_text.setString(std::to_string(weight)); 
-                                weight_text.setPosition((graph.getVertices()[selected_vertex].getPosition() + graph.getVertices()[i].getPosition()) / 2.f);
+                                weight_text.setPosition((view.getVertices()[selected_vertex].getPosition() + view.getVertices()[i].getPosition()) / 2.f);
 
                                 // The triangle indicating the direction of the edge
                                 sf::ConvexShape triangle(3);
@@ -214,16 +235,17 @@ void WeightedPage::Display(sf::RenderWindow& window) {
 
                                 // The position of the direction triangle
                                 float triangle_distance_before_vertex = -40.0f;
-                                sf::Vector2f triangle_position = graph.getVertices()[i].getPosition() + sf::Vector2f(vertex_size, vertex_size);
+                                sf::Vector2f triangle_position = view.getVertices()[i].getPosition() + sf::Vector2f(vertex_size, vertex_size);
                                 triangle_position.x += triangle_distance_before_vertex * cos(angle * PI / 180);
                                 triangle_position.y += triangle_distance_before_vertex * sin(angle * PI / 180);
                                 triangle.setPosition(triangle_position);
 
-                                graph.AddTriangle(triangle);
+                                view.AddTriangle(triangle);
 
-                                graph.ChangeVertexColor(sf::Color::White, selected_vertex);
+                                view.ChangeVertexColor(sf::Color::White, selected_vertex);
 
-                                graph.AddEdge(selected_vertex, i, weight, edge, weight_text);
+                                view.AddEdge(edge, weight_text);
+                                graph.AddEdge(selected_vertex, i, weight);
 
                                 selected_vertex = -1;
                             }
@@ -232,6 +254,7 @@ void WeightedPage::Display(sf::RenderWindow& window) {
                     }
                     if (!vertex_clicked && selected_vertex == -1 && graph_frame.getGlobalBounds().contains(position.x, position.y)) {
                         graph.Reset();
+                        view.ResetColors();
                         
                         // Draw a vertex inside the graph frame
                         sf::CircleShape vertex(vertex_size);
@@ -243,18 +266,19 @@ void WeightedPage::Display(sf::RenderWindow& window) {
                         // Draw the vertex number
                         sf::Text vertex_number;
                         vertex_number.setFont(font);
-                        vertex_number.setString(std::to_string(graph.getVertices().size()));
+                        vertex_number.setString(std::to_string(view.getVertices().size()));
                         vertex_number.setCharacterSize(40);
                         vertex_number.setFillColor(sf::Color::Black);
                         vertex_number.setPosition(vertex.getPosition().x + vertex.getLocalBounds().width / 2.f - vertex_size / 2, vertex.getPosition().y + vertex.getLocalBounds().height / 2.f - vertex_size);
 
-                        graph.AddVertex(vertex, vertex_number);
+                        view.AddVertex(vertex, vertex_number);
+                        graph.AddVertex();
                     }
                 }
                 else if (event.mouseButton.button == sf::Mouse::Right) {
                     // Reset the vertex selected
                     if (selected_vertex != -1) {
-                        graph.ChangeVertexColor(sf::Color::White, selected_vertex);
+                        view.ChangeVertexColor(sf::Color::White, selected_vertex);
                     }
                     selected_vertex = -1;
                 }
@@ -263,26 +287,14 @@ void WeightedPage::Display(sf::RenderWindow& window) {
 
         // Based on what algorithm is picked start a simulation
         if (elapsed.asSeconds() >= step_interval && algorithm_picker != AlgorithmPicked::None) {
-            switch (algorithm_picker) {
-            case AlgorithmPicked::Dijkstra:
-                graph.RunDijkstra();
-                break;
-            case AlgorithmPicked::BFS:
-                graph.RunBFS();
-                break;
-            case AlgorithmPicked::Bellman_Ford:
-                graph.RunBellmanFord();
-                break;
-            case AlgorithmPicked::DFS:
-                graph.RunDFS();
-                break;
-            }
+            graph.RunSteps(1, true); // The graph remembers the algorithm which was set up
+            view.Consume(graph);
             timer.restart();
         }
 
         // If the simulation finished show the path from the source to the ending node
         if (graph.getFinished() && (algorithm_picker != AlgorithmPicked::None)) {
-            graph.TracePath();
+            view.ShowPath(graph);
             algorithm_picker = AlgorithmPicked::None;
         }
 
@@ -293,7 +305,8 @@ void WeightedPage::Display(sf::RenderWindow& window) {
         bfs_button.Draw(window);
         dfs_button.Draw(window);
         bellman_ford_button.Draw(window);
-        graph.Draw(window);
+        spfa_button.Draw(window);
+        view.Draw(window);
         reset_button.Draw(window);
         window.display();
     }
@@ -1,84 +1,170 @@
 #include "../headers/WeightedGraph.hpp"
+#include "../headers/ThreadPool.hpp"
 
 #include <iostream>
 #include <climits>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#define DELTA_CHUNK 64 // Vertices of a bucket a thread takes at once
+#define DELTA_MAX_BUCKETS 4096 // The width is raised until the ring of buckets holds every weight with this many buckets
 
 WeightedGraph::WeightedGraph() {
 	finished = false;
+	algorithm = GraphAlgorithm::None;
+	source = 0;
+	destination = -1;
+	expansions = 0;
+	landmarks = nullptr;
+	frozen = false;
+	vertex_count = 0;
 	bellman_curr_edge = 0;
 	bellman_curr_vertex = 0;
+	bellman_curr_round = 0;
+	bellman_relaxed = false;
+	spfa_queue_sum = 0;
 }
 
-void WeightedGraph::AddEdge(const int& from, const int& to, const int& weight, const sf::VertexArray& edge, const sf::Text& weight_graphics) {
-	adjacency_list[from].push_back({ to, weight });
-	edges.push_back(edge);
-	edge_weights.push_back(weight_graphics);
-}
-
-std::vector<std::pair<int, int>> WeightedGraph::getAdjacencyList(const int& vertex) {
-	return adjacency_list[vertex];
+void WeightedGraph::AddEdge(const int& from, const int& to, const int& weight) {
+	if (frozen) {
+		Thaw();
+	}
+	edge_builder.push_back({ from, to, weight });
 }
 
-void WeightedGraph::Clear() {
-	finished = false;
-	distances.clear();
-	parents.clear();
-	adjacency_list.clear();
-	vertices.clear();
-	vertex_numbers.clear();
-	edges.clear();
-	edge_weights.clear();
-	edge_going_to_signaling_triangles.clear();
+void WeightedGraph::Freeze() {
+	// Vertices added to a frozen graph need their own rows, the edges are packed again
+	if (frozen && static_cast<int>(csr_offsets.size()) == vertex_count + 1) {
+		return;
+	}
+	if (frozen) {
+		Thaw();
+	}
+	// Counting sort by the start of the edges, it keeps the order in which the edges of a vertex were added
+	csr_offsets.assign(vertex_count + 1, 0);
+	for (const GraphEdge& edge : edge_builder) {
+		if (edge.from >= 0 && edge.from < vertex_count && edge.to >= 0 && edge.to < vertex_count) {
+			csr_offsets[edge.from + 1]++;
+		}
+	}
+	for (int v = 0; v < vertex_count; v++) {
+		csr_offsets[v + 1] += csr_offsets[v];
+	}
+	csr_targets.assign(csr_offsets[vertex_count], 0);
+	csr_weights.assign(csr_offsets[vertex_count], 0);
+	std::vector<int> fill(csr_offsets.begin(), csr_offsets.end() - 1);
+	for (const GraphEdge& edge : edge_builder) {
+		if (edge.from >= 0 && edge.from < vertex_count && edge.to >= 0 && edge.to < vertex_count) {
+			csr_targets[fill[edge.from]] = edge.to;
+			csr_weights[fill[edge.from]] = edge.weight;
+			fill[edge.from]++;
+		}
+	}
+	std::vector<GraphEdge>().swap(edge_builder);
+	frozen = true;
 }
 
-void WeightedGraph::AddVertex(const sf::CircleShape& vertex, const sf::Text& vertex_number) {
-	vertices.push_back(vertex);
-	vertex_numbers.push_back(vertex_number);
+void WeightedGraph::Thaw() {
+	edge_builder.clear();
+	edge_builder.reserve(csr_targets.size());
+	ForEachEdge([&](const int& from, const int& to, const int& weight) {
+		edge_builder.push_back({ from, to, weight });
+	});
+	std::vector<int>().swap(csr_offsets);
+	std::vector<int>().swap(csr_targets);
+	std::vector<int>().swap(csr_weights);
+	frozen = false;
 }
 
-void WeightedGraph::ChangeVertexColor(const sf::Color& color, const int& index) {
-	vertices[index].setFillColor(color);
+void WeightedGraph::LoadCompressedRows(const int& vertices, std::vector<int>&& offsets, std::vector<int>&& targets,
+	std::vector<int>&& weights) {
+	Clear();
+	std::vector<GraphEdge>().swap(edge_builder);
+	csr_offsets = std::move(offsets);
+	csr_targets = std::move(targets);
+	csr_weights = std::move(weights);
+	vertex_count = vertices;
+	frozen = true;
 }
 
-std::vector<sf::CircleShape> WeightedGraph::getVertices() {
-	return vertices;
+bool WeightedGraph::isFrozen() const {
+	return frozen;
 }
 
-void WeightedGraph::Draw(sf::RenderWindow& window) {
-	for (size_t i = 0; i < edges.size(); ++i) {
-		window.draw(edges[i]);
-		window.draw(edge_weights[i]);
-	}
-	for (const auto& vertex : vertices) {
-		window.draw(vertex);
+int WeightedGraph::getEdgeWeight(const int& from, const int& to) const {
+	int weight = INT_MAX;
+	if (!frozen || from < 0 || from + 1 >= static_cast<int>(csr_offsets.size())) {
+		return weight;
 	}
-	for (const auto& vertex_number : vertex_numbers) {
-		window.draw(vertex_number);
-	}
-	for (const auto& triangle : edge_going_to_signaling_triangles) {
-		window.draw(triangle);
+	for (int i = csr_offsets[from]; i < csr_offsets[from + 1]; i++) {
+		if (csr_targets[i] == to && csr_weights[i] < weight) {
+			weight = csr_weights[i];
+		}
 	}
+	return weight;
 }
 
-void WeightedGraph::AddTriangle(const sf::ConvexShape& triangle) {
-	edge_going_to_signaling_triangles.push_back(triangle);
+const std::vector<int>& WeightedGraph::getEdgeOffsets() const {
+	return csr_offsets;
 }
 
-void WeightedGraph::RunDijkstra() {
+const std::vector<int>& WeightedGraph::getEdgeTargets() const {
+	return csr_targets;
+}
+
+const std::vector<int>& WeightedGraph::getEdgeWeights() const {
+	return csr_weights;
+}
+
+int WeightedGraph::getEdgeCount() const {
+	return static_cast<int>(frozen ? csr_targets.size() : edge_builder.size());
+}
+
+size_t WeightedGraph::getMemoryUsage() const {
+	return edge_builder.capacity() * sizeof(GraphEdge)
+		+ (csr_offsets.capacity() + csr_targets.capacity() + csr_weights.capacity()) * sizeof(int)
+		+ (distances.capacity() + parents.capacity()) * sizeof(int) + visited.capacity() / 8
+		+ (tree_next.capacity() + tree_previous.capacity() + tree_depth.capacity()) * sizeof(int) + spfa_queued.capacity() / 8;
+}
+
+void WeightedGraph::Clear() {
+	finished = false;
+	algorithm = GraphAlgorithm::None;
+	distances.clear();
+	parents.clear();
+	edge_builder.clear();
+	csr_offsets.clear();
+	csr_targets.clear();
+	csr_weights.clear();
+	frozen = false;
+	vertex_count = 0;
+	events.clear();
+}
+
+void WeightedGraph::AddVertex() {
+	vertex_count++;
+}
+
+template<bool Animate>
+void WeightedGraph::StepDijkstra() {
 	if (finished) {
 		return;
 	}
 	if (!dijkstra_priority_queue.empty()) {
 		int distance = dijkstra_priority_queue.top().first;
 		int vertex = dijkstra_priority_queue.top().second;
-		vertices[vertex].setFillColor(sf::Color::Magenta);
 		dijkstra_priority_queue.pop();
 
 		if (distance > distances[vertex]) return;
+		if (Animate) {
+			events.push_back({ GraphEventType::Visit, vertex, -1, distances[vertex] });
+		}
+		expansions++;
 
-		for (auto edge : adjacency_list[vertex]) {
-			int next_vertex = edge.first;
-			int edge_weight = edge.second;
+		for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+			int next_vertex = csr_targets[i];
+			int edge_weight = csr_weights[i];
 
 			if (distances[vertex] + edge_weight < distances[next_vertex]) {
 				distances[next_vertex] = distances[vertex] + edge_weight;
@@ -101,20 +187,188 @@ void WeightedGraph::SetUpDijkstra() {
 	while (!dijkstra_priority_queue.empty()) {
 		dijkstra_priority_queue.pop();
 	}
-	dijkstra_priority_queue.push(std::make_pair(0, 0));
+	dijkstra_priority_queue.push(std::make_pair(0, source));
+	algorithm = GraphAlgorithm::Dijkstra;
 }
 
-void WeightedGraph::RunBFS() {
+int WeightedGraph::SuggestDelta() const {
+	// Meyer and Sanders: with the largest weight over the average degree a bucket needs few light phases to settle
+	// and still holds enough vertices to keep the threads busy
+	int max_weight = 0;
+	ForEachEdge([&](const int&, const int&, const int& weight) {
+		max_weight = std::max(max_weight, weight);
+	});
+	if (vertex_count == 0 || getEdgeCount() == 0) {
+		return 1;
+	}
+	double degree = std::max(1.0, static_cast<double>(getEdgeCount()) / vertex_count);
+	return std::max(1, static_cast<int>(max_weight / degree));
+}
+
+bool WeightedGraph::RunDeltaStepping(ThreadPool& pool, const int& delta) {
+	Reset();
+	finished = true;
+	if (vertex_count == 0) {
+		return true;
+	}
+	int max_weight = 0;
+	for (int weight : csr_weights) {
+		if (weight < 0) {
+			std::cerr << "Delta-stepping needs edges without negative weights" << std::endl;
+			return false;
+		}
+		max_weight = std::max(max_weight, weight);
+	}
+	int width = std::max(delta > 0 ? delta : SuggestDelta(), max_weight / DELTA_MAX_BUCKETS + 1);
+	// A relaxation moves a vertex at most max_weight / width buckets ahead, so the buckets are a ring of that many,
+	// an entry of slot s belongs to the only bucket ahead of the current one which falls on s
+	uint32_t ring = max_weight / width + 2;
+	int threads = pool.getThreadCount();
+
+	// The distance and the parent of a vertex are packed in one word with the distance in the high half, so one
+	// compare and swap lowers both and a parent always belongs to its distance
+	std::unique_ptr<std::atomic<uint64_t>[]> labels(new std::atomic<uint64_t>[vertex_count]);
+	std::unique_ptr<std::atomic<uint32_t>[]> phase_stamps(new std::atomic<uint32_t>[vertex_count]);
+	std::unique_ptr<std::atomic<uint32_t>[]> bucket_stamps(new std::atomic<uint32_t>[vertex_count]);
+	std::vector<std::vector<std::vector<int>>> bins(threads, std::vector<std::vector<int>>(ring));
+	std::vector<std::vector<int>> frontiers(threads);
+	std::vector<std::vector<int>> removed(threads);
+	std::vector<size_t> frontier_sizes(threads);
+	std::vector<long long> processed(threads, 0);
+	std::atomic<size_t> cursor(0);
+	uint32_t bucket = 0;
+	uint32_t phase = 0;
+	bool done = false;
+
+	auto relax = [&](const int& worker, const int& vertex, const long long& distance, const bool& light) {
+		for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+			int weight = csr_weights[i];
+			long long next_distance = distance + weight;
+			if ((weight <= width) != light || next_distance >= INT_MAX) {
+				continue;
+			}
+			int next_vertex = csr_targets[i];
+			uint64_t label = labels[next_vertex].load(std::memory_order_relaxed);
+			uint64_t better = static_cast<uint64_t>(next_distance) << 32 | static_cast<uint32_t>(vertex);
+			while (static_cast<long long>(label >> 32) > next_distance) {
+				if (labels[next_vertex].compare_exchange_weak(label, better, std::memory_order_relaxed)) {
+					bins[worker][(next_distance / width) % ring].push_back(next_vertex);
+					break;
+				}
+			}
+		}
+	};
+
+	pool.Run([&](int worker) {
+		int begin = static_cast<int>(static_cast<long long>(vertex_count) * worker / threads);
+		int end = static_cast<int>(static_cast<long long>(vertex_count) * (worker + 1) / threads);
+		for (int v = begin; v < end; v++) {
+			labels[v].store(static_cast<uint64_t>(INT_MAX) << 32 | UINT32_MAX, std::memory_order_relaxed);
+			phase_stamps[v].store(UINT32_MAX, std::memory_order_relaxed);
+			bucket_stamps[v].store(UINT32_MAX, std::memory_order_relaxed);
+		}
+		pool.Barrier();
+		if (worker == 0) {
+			labels[source].store(UINT32_MAX, std::memory_order_relaxed);
+			bins[0][0].push_back(source);
+		}
+		long long settled = 0;
+
+		while (!done) {
+			uint32_t current = bucket;
+			uint32_t slot = current % ring;
+			// Light phases: the vertices put back into the current bucket are taken again until none is
+			while (true) {
+				frontiers[worker].clear();
+				frontiers[worker].swap(bins[worker][slot]);
+				frontier_sizes[worker] = frontiers[worker].size();
+				if (worker == 0) {
+					cursor.store(0, std::memory_order_relaxed);
+					phase++;
+				}
+				pool.Barrier();
+				size_t total = 0;
+				for (size_t size : frontier_sizes) {
+					total += size;
+				}
+				if (total == 0) {
+					break;
+				}
+				// The frontiers of the threads are taken in chunks as if they were one list
+				for (size_t index = cursor.fetch_add(DELTA_CHUNK); index < total; index = cursor.fetch_add(DELTA_CHUNK)) {
+					size_t stop = std::min(index + DELTA_CHUNK, total);
+					int owner = 0;
+					size_t offset = index;
+					for (; index < stop; index++, offset++) {
+						while (offset >= frontier_sizes[owner]) {
+							offset -= frontier_sizes[owner];
+							owner++;
+						}
+						int vertex = frontiers[owner][offset];
+						long long distance = static_cast<long long>(labels[vertex].load(std::memory_order_relaxed) >> 32);
+						// Entries left behind by a later lowering of the distance, and repeated entries of one phase, are skipped
+						if (distance / width != current || phase_stamps[vertex].exchange(phase, std::memory_order_relaxed) == phase) {
+							continue;
+						}
+						if (bucket_stamps[vertex].exchange(current, std::memory_order_relaxed) != current) {
+							removed[worker].push_back(vertex);
+						}
+						settled++;
+						relax(worker, vertex, distance, true);
+					}
+				}
+				pool.Barrier();
+			}
+
+			// Heavy edges lead to later buckets, they are relaxed once from the final distances of the bucket
+			for (int vertex : removed[worker]) {
+				relax(worker, vertex, static_cast<long long>(labels[vertex].load(std::memory_order_relaxed) >> 32), false);
+			}
+			removed[worker].clear();
+			pool.Barrier();
+			if (worker == 0) {
+				done = true;
+				for (uint32_t step = 1; step < ring && done; step++) {
+					for (int t = 0; t < threads && done; t++) {
+						if (!bins[t][(current + step) % ring].empty()) {
+							bucket = current + step;
+							done = false;
+						}
+					}
+				}
+			}
+			pool.Barrier();
+		}
+
+		for (int v = begin; v < end; v++) {
+			uint64_t label = labels[v].load(std::memory_order_relaxed);
+			distances[v] = static_cast<int>(label >> 32);
+			parents[v] = static_cast<int>(static_cast<uint32_t>(label));
+		}
+		processed[worker] = settled;
+	});
+
+	for (long long count : processed) {
+		expansions += count;
+	}
+	return true;
+}
+
+template<bool Animate>
+void WeightedGraph::StepBFS() {
 	if (finished) {
 		return;
 	}
 	if (!bfs_queue.empty()) {
 		int vertex = bfs_queue.front();
 		bfs_queue.pop();
-		vertices[vertex].setFillColor(sf::Color::Magenta);
+		if (Animate) {
+			events.push_back({ GraphEventType::Visit, vertex, -1, distances[vertex] });
+		}
+		expansions++;
 
-		for (auto edge : adjacency_list[vertex]) {
-			int next_vertex = edge.first;
+		for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+			int next_vertex = csr_targets[i];
 			if (!visited[next_vertex]) {
 				visited[next_vertex] = true;
 				bfs_queue.push(next_vertex);
@@ -132,20 +386,25 @@ void WeightedGraph::SetUpBFS() {
 	while (!bfs_queue.empty()) {
 		bfs_queue.pop();
 	}
-	bfs_queue.push(0);
+	bfs_queue.push(source);
+	algorithm = GraphAlgorithm::BFS;
 }
 
-void WeightedGraph::RunDFS() {
+template<bool Animate>
+void WeightedGraph::StepDFS() {
 	if (finished) {
 		return;
 	}
 	if (!dfs_stack.empty()) {
 		int vertex = dfs_stack.top();
 		dfs_stack.pop();
-		vertices[vertex].setFillColor(sf::Color::Magenta);
+		if (Animate) {
+			events.push_back({ GraphEventType::Visit, vertex, -1, distances[vertex] });
+		}
+		expansions++;
 
-		for (auto edge : adjacency_list[vertex]) {
-			int next_vertex = edge.first;
+		for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+			int next_vertex = csr_targets[i];
 			if (!visited[next_vertex]) {
 				visited[next_vertex] = true;
 				dfs_stack.push(next_vertex);
@@ -163,42 +422,59 @@ void WeightedGraph::SetUpDFS() {
 	while (!dfs_stack.empty()) {
 		dfs_stack.pop();
 	}
-	dfs_stack.push(0);
-	
+	dfs_stack.push(source);
+	algorithm = GraphAlgorithm::DFS;
 }
 
-void WeightedGraph::RunBellmanFord() {
+template<bool Animate>
+void WeightedGraph::StepBellmanFord() {
 	if (finished) {
 		return;
 	}
-	if (bellman_curr_vertex < vertices.size()) {
-		if (bellman_curr_edge < adjacency_list[bellman_curr_vertex].size()) {
+	if (bellman_curr_vertex < vertex_count) {
+		if (bellman_curr_edge < csr_offsets[bellman_curr_vertex + 1]) {
 			int u = bellman_curr_vertex;
-			int v = adjacency_list[u][bellman_curr_edge].first;
-			int weight = adjacency_list[u][bellman_curr_edge].second;
+			int v = csr_targets[bellman_curr_edge];
+			int weight = csr_weights[bellman_curr_edge];
+			expansions++;
 			if (distances[u] != INT_MAX && distances[u] + weight < distances[v]) {
 				distances[v] = distances[u] + weight;
 				parents[v] = u;
-				vertices[v].setFillColor(sf::Color::Magenta);
+				bellman_relaxed = true;
+				if (Animate) {
+					events.push_back({ GraphEventType::Relax, v, u, distances[v] });
+				}
 			}
 
 			bellman_curr_edge++;
 		}
 		else {
-			
 			bellman_curr_vertex++;
-			bellman_curr_edge = 0;
+			bellman_curr_edge = csr_offsets[bellman_curr_vertex];
 		}
 	}
+	else if (!bellman_relaxed) {
+		// A pass which lowered no distance leaves the next ones nothing to do, the distances are final and there is no negative cycle
+		finished = true;
+	}
+	else if (bellman_curr_round + 2 < vertex_count) {
+		// Bellman-Ford needs |V| - 1 passes over the edges, start the next pass
+		bellman_curr_round++;
+		bellman_curr_vertex = 0;
+		bellman_curr_edge = csr_offsets[0];
+		bellman_relaxed = false;
+	}
 	else {
-		for (const auto& item : adjacency_list) {
-			int u = item.first;
-			for (const auto& edge : item.second) {
-				int v = edge.first;
-				int weight = edge.second;
+		for (int u = 0; u < vertex_count; u++) {
+			for (int i = csr_offsets[u]; i < csr_offsets[u + 1]; i++) {
+				int v = csr_targets[i];
+				int weight = csr_weights[i];
 				if (distances[u] != INT_MAX && distances[u] + weight < distances[v]) {
-					std::cout << "Graph contains negative weight cycle" << std::endl;
-					vertices[v].setFillColor(sf::Color::Red);
+					std::cerr << "Graph contains negative weight cycle" << std::endl;
+					// After |V| - 1 passes the parents of a vertex which can still be lowered lead into the cycle
+					distances[v] = distances[u] + weight;
+					parents[v] = u;
+					ExtractNegativeCycle<Animate>(v);
 					finished = true;
 					return;
 				}
@@ -209,46 +485,356 @@ void WeightedGraph::RunBellmanFord() {
 	}
 }
 
+template<bool Animate>
+void WeightedGraph::ExtractNegativeCycle(int vertex) {
+	// Walking |V| parents back surely ends on the cycle, it is then walked once around and turned to the order of the edges
+	negative_cycle.clear();
+	for (int i = 0; i < vertex_count && vertex != -1; i++) {
+		vertex = parents[vertex];
+	}
+	if (vertex == -1) {
+		return;
+	}
+	int v = vertex;
+	do {
+		negative_cycle.push_back(v);
+		v = parents[v];
+	} while (v != vertex && static_cast<int>(negative_cycle.size()) <= vertex_count);
+	std::reverse(negative_cycle.begin(), negative_cycle.end());
+	if (Animate) {
+		for (int cycle_vertex : negative_cycle) {
+			events.push_back({ GraphEventType::NegativeCycle, cycle_vertex, parents[cycle_vertex], distances[cycle_vertex] });
+		}
+	}
+}
+
 void WeightedGraph::SetUpBellmanFord() {
 	Reset();
 	bellman_curr_vertex = 0;
 	bellman_curr_edge = 0;
+	bellman_curr_round = 0;
+	bellman_relaxed = false;
+	algorithm = GraphAlgorithm::BellmanFord;
 }
 
-void WeightedGraph::TracePath() {
-	finished = false;
-	int destination = vertices.size() - 1;
+void WeightedGraph::PushSPFA(const int& vertex) {
+	if (!spfa_queue.empty() && distances[vertex] < distances[spfa_queue.front()]) {
+		spfa_queue.push_front(vertex);
+	}
+	else {
+		spfa_queue.push_back(vertex);
+	}
+	spfa_queued[vertex] = true;
+	spfa_queue_sum += distances[vertex];
+}
 
-	if (destination == -1) {
-		std::cerr << "The graph was empty" << std::endl;
+bool WeightedGraph::MoveInTree(const int& vertex, const int& parent) {
+	if (vertex == parent) {
+		return false;
+	}
+	if (tree_depth[vertex] != -1) {
+		// The subtree of the vertex follows it in preorder as long as the depth is larger, its vertices leave the tree
+		int last = tree_next[vertex];
+		while (last != -1 && tree_depth[last] > tree_depth[vertex]) {
+			if (last == parent) {
+				return false;
+			}
+			tree_depth[last] = -1;
+			last = tree_next[last];
+		}
+		if (tree_previous[vertex] != -1) {
+			tree_next[tree_previous[vertex]] = last;
+		}
+		if (last != -1) {
+			tree_previous[last] = tree_previous[vertex];
+		}
+	}
+	// The vertex has no children left, it becomes the first child of its parent
+	tree_depth[vertex] = tree_depth[parent] + 1;
+	tree_previous[vertex] = parent;
+	tree_next[vertex] = tree_next[parent];
+	if (tree_next[parent] != -1) {
+		tree_previous[tree_next[parent]] = vertex;
+	}
+	tree_next[parent] = vertex;
+	return true;
+}
+
+template<bool Animate>
+void WeightedGraph::StepSPFA() {
+	if (finished) {
 		return;
 	}
-	if (parents[destination] == -1) {
-		std::cout << "No path from source to destination exists." << std::endl;
+	if (spfa_queue.empty()) {
+		finished = true;
 		return;
 	}
+	// Large Label Last: a first vertex above the average distance of the queue waits at the back
+	for (size_t moved = 0; moved < spfa_queue.size() && distances[spfa_queue.front()] * static_cast<long long>(spfa_queue.size()) > spfa_queue_sum; moved++) {
+		spfa_queue.push_back(spfa_queue.front());
+		spfa_queue.pop_front();
+	}
+	int vertex = spfa_queue.front();
+	spfa_queue.pop_front();
+	spfa_queued[vertex] = false;
+	spfa_queue_sum -= distances[vertex];
+	// A vertex whose subtree was removed is reached again through the ancestor which was lowered
+	if (tree_depth[vertex] == -1) {
+		return;
+	}
+	if (Animate) {
+		events.push_back({ GraphEventType::Visit, vertex, -1, distances[vertex] });
+	}
+	expansions++;
+
+	for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+		int next_vertex = csr_targets[i];
+		int edge_weight = csr_weights[i];
+		if (distances[vertex] + edge_weight >= distances[next_vertex]) {
+			continue;
+		}
+		int lowered = distances[vertex] + edge_weight;
+		if (!MoveInTree(next_vertex, vertex)) {
+			std::cerr << "Graph contains negative weight cycle" << std::endl;
+			distances[next_vertex] = lowered;
+			parents[next_vertex] = vertex;
+			ExtractNegativeCycle<Animate>(vertex);
+			finished = true;
+			return;
+		}
+		if (spfa_queued[next_vertex]) {
+			spfa_queue_sum += static_cast<long long>(lowered) - distances[next_vertex];
+		}
+		distances[next_vertex] = lowered;
+		parents[next_vertex] = vertex;
+		if (Animate) {
+			events.push_back({ GraphEventType::Relax, next_vertex, vertex, lowered });
+		}
+		if (!spfa_queued[next_vertex]) {
+			PushSPFA(next_vertex);
+		}
+	}
+}
+
+void WeightedGraph::SetUpSPFA() {
+	Reset();
+	spfa_queue.clear();
+	spfa_queue_sum = 0;
+	spfa_queued.assign(vertex_count, false);
+	tree_next.assign(vertex_count, -1);
+	tree_previous.assign(vertex_count, -1);
+	tree_depth.assign(vertex_count, -1);
+	algorithm = GraphAlgorithm::SPFA;
+	if (vertex_count == 0) {
+		return;
+	}
+	tree_depth[source] = 0;
+	PushSPFA(source);
+}
+
+const std::vector<int>& WeightedGraph::getNegativeCycle() const {
+	return negative_cycle;
+}
+
+int WeightedGraph::Estimate(const int& vertex) const {
+	// Tables built for another graph would not be lower bounds, they are ignored
+	if (landmarks == nullptr || landmarks->getVertexCount() != static_cast<uint32_t>(vertex_count)) {
+		return 0;
+	}
+	return landmarks->LowerBound(vertex, getDestination());
+}
+
+template<bool Animate>
+void WeightedGraph::StepAStar() {
+	if (finished) {
+		return;
+	}
+	if (!dijkstra_priority_queue.empty()) {
+		int key = dijkstra_priority_queue.top().first;
+		int vertex = dijkstra_priority_queue.top().second;
+		dijkstra_priority_queue.pop();
+
+		// The queue is keyed by the distance plus the lower bound, an entry with a larger key is outdated
+		if (key > distances[vertex] + Estimate(vertex)) return;
+		if (Animate) {
+			events.push_back({ GraphEventType::Visit, vertex, -1, distances[vertex] });
+		}
+		expansions++;
+		if (vertex == getDestination()) {
+			finished = true;
+			return;
+		}
+
+		for (int i = csr_offsets[vertex]; i < csr_offsets[vertex + 1]; i++) {
+			int next_vertex = csr_targets[i];
+			int edge_weight = csr_weights[i];
+
+			if (distances[vertex] + edge_weight < distances[next_vertex]) {
+				distances[next_vertex] = distances[vertex] + edge_weight;
+				parents[next_vertex] = vertex;
+				dijkstra_priority_queue.push({ distances[next_vertex] + Estimate(next_vertex), next_vertex });
+			}
+		}
+	}
+	else {
+		finished = true;
+	}
+}
+
+void WeightedGraph::SetUpAStar() {
+	Reset();
+	while (!dijkstra_priority_queue.empty()) {
+		dijkstra_priority_queue.pop();
+	}
+	dijkstra_priority_queue.push(std::make_pair(Estimate(source), source));
+	algorithm = GraphAlgorithm::AStar;
+}
+
+void WeightedGraph::setLandmarks(const Landmarks* landmarks) {
+	this->landmarks = landmarks;
+}
 
-	for (int v = destination; v != -1; v = parents[v]) {
-		vertices[v].setFillColor(sf::Color::Yellow);
+// The public single steps are used by the animated page and record events, RunSteps picks the algorithm
+// once and then calls its step in a tight loop.
+
+void WeightedGraph::RunDijkstra() {
+	StepDijkstra<true>();
+}
+
+void WeightedGraph::RunBFS() {
+	StepBFS<true>();
+}
+
+void WeightedGraph::RunDFS() {
+	StepDFS<true>();
+}
+
+void WeightedGraph::RunBellmanFord() {
+	StepBellmanFord<true>();
+}
+
+void WeightedGraph::RunAStar() {
+	StepAStar<true>();
+}
+
+void WeightedGraph::RunSPFA() {
+	StepSPFA<true>();
+}
+
+template<bool Animate>
+long long WeightedGraph::RunStepsOf(const long long& steps) {
+	long long done = 0;
+	switch (algorithm) {
+	case GraphAlgorithm::Dijkstra:
+		for (; done < steps && !finished; done++) StepDijkstra<Animate>();
+		break;
+	case GraphAlgorithm::BFS:
+		for (; done < steps && !finished; done++) StepBFS<Animate>();
+		break;
+	case GraphAlgorithm::DFS:
+		for (; done < steps && !finished; done++) StepDFS<Animate>();
+		break;
+	case GraphAlgorithm::BellmanFord:
+		for (; done < steps && !finished; done++) StepBellmanFord<Animate>();
+		break;
+	case GraphAlgorithm::AStar:
+		for (; done < steps && !finished; done++) StepAStar<Animate>();
+		break;
+	case GraphAlgorithm::SPFA:
+		for (; done < steps && !finished; done++) StepSPFA<Animate>();
+		break;
+	case GraphAlgorithm::None:
+		break;
 	}
-	vertices[0].setFillColor(sf::Color::Green);
-	vertices[vertices.size() - 1].setFillColor(sf::Color::Red);
+	return done;
+}
+
+long long WeightedGraph::RunSteps(const long long& steps, const bool& animate) {
+	return animate ? RunStepsOf<true>(steps) : RunStepsOf<false>(steps);
+}
+
+long long WeightedGraph::RunToCompletion() {
+	return RunStepsOf<false>(LLONG_MAX);
+}
+
+std::vector<int> WeightedGraph::TracePath() const {
+	std::vector<int> path;
+	int target = getDestination();
+	if (target == -1 || static_cast<int>(parents.size()) != vertex_count || (target != source && parents[target] == -1)) {
+		return path;
+	}
+
+	// A negative cycle can close the parents into a loop which never reaches the source, there is no path then
+	for (int v = target; v != -1 && static_cast<int>(path.size()) <= vertex_count; v = v == source ? -1 : parents[v]) {
+		path.push_back(v);
+	}
+	if (path.back() != source) {
+		path.clear();
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
 }
 
 void WeightedGraph::Reset() {
+	Freeze();
 	finished = false;
-	for (size_t i = 0; i < vertices.size(); ++i) {
-		vertices[i].setFillColor(sf::Color::White);
-	}
-	if (vertices.size() == 0) {
+	expansions = 0;
+	algorithm = GraphAlgorithm::None;
+	events.clear();
+	negative_cycle.clear();
+	if (vertex_count == 0) {
 		finished = true;
 		return;
 	}
-	visited.clear();
-	parents.clear();
-	parents.resize(vertices.size(), -1);
-	distances.resize(vertices.size(), INT16_MAX);
-	distances[0] = 0;
-	visited.resize(vertices.size(), false);
-	visited[0] = true;
+	if (source < 0 || source >= vertex_count) {
+		source = 0;
+	}
+	parents.assign(vertex_count, -1);
+	distances.assign(vertex_count, INT_MAX);
+	distances[source] = 0;
+	visited.assign(vertex_count, false);
+	visited[source] = true;
+}
+
+const std::vector<GraphEvent>& WeightedGraph::getEvents() const {
+	return events;
+}
+
+void WeightedGraph::ClearEvents() {
+	events.clear();
+}
+
+void WeightedGraph::setSource(const int& vertex) {
+	source = vertex;
+}
+
+int WeightedGraph::getSource() const {
+	return source;
+}
+
+void WeightedGraph::setDestination(const int& vertex) {
+	destination = vertex;
+}
+
+int WeightedGraph::getDestination() const {
+	if (destination >= 0 && destination < vertex_count) {
+		return destination;
+	}
+	return vertex_count - 1;
+}
+
+int WeightedGraph::getVertexCount() const {
+	return vertex_count;
+}
+
+const std::vector<int>& WeightedGraph::getDistances() const {
+	return distances;
+}
+
+const std::vector<int>& WeightedGraph::getParents() const {
+	return parents;
+}
+
+long long WeightedGraph::getExpansions() const {
+	return expansions;
 }
\ No newline at end of file
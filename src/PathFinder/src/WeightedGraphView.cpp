@@ -0,0 +1,91 @@
+#include "../headers/WeightedGraphView.hpp"
+
+#include <iostream>
+
+void WeightedGraphView::AddVertex(const sf::CircleShape& vertex, const sf::Text& vertex_number) {
+	vertices.push_back(vertex);
+	vertex_numbers.push_back(vertex_number);
+}
+
+void WeightedGraphView::AddEdge(const sf::VertexArray& edge, const sf::Text& weight_graphics) {
+	edges.push_back(edge);
+	edge_weights.push_back(weight_graphics);
+}
+
+void WeightedGraphView::AddTriangle(const sf::ConvexShape& triangle) {
+	edge_going_to_signaling_triangles.push_back(triangle);
+}
+
+void WeightedGraphView::Clear() {
+	vertices.clear();
+	vertex_numbers.clear();
+	edges.clear();
+	edge_weights.clear();
+	edge_going_to_signaling_triangles.clear();
+}
+
+void WeightedGraphView::ChangeVertexColor(const sf::Color& color, const int& index) {
+	vertices[index].setFillColor(color);
+}
+
+void WeightedGraphView::ResetColors() {
+	for (sf::CircleShape& vertex : vertices) {
+		vertex.setFillColor(sf::Color::White);
+	}
+}
+
+void WeightedGraphView::Consume(WeightedGraph& graph) {
+	for (const GraphEvent& event : graph.getEvents()) {
+		if (event.vertex < 0 || event.vertex >= static_cast<int>(vertices.size())) {
+			continue;
+		}
+		vertices[event.vertex].setFillColor(event.type == GraphEventType::NegativeCycle ? sf::Color::Red : sf::Color::Magenta);
+	}
+	graph.ClearEvents();
+}
+
+void WeightedGraphView::ShowPath(const WeightedGraph& graph) {
+	std::vector<int> path = graph.TracePath();
+	if (graph.getVertexCount() == 0) {
+		std::cerr << "The graph was empty" << std::endl;
+		return;
+	}
+	// The vertices of a negative cycle were colored red by its events, there is no shortest path to show
+	if (!graph.getNegativeCycle().empty()) {
+		std::cout << "Negative cycle:";
+		for (int vertex : graph.getNegativeCycle()) {
+			std::cout << " " << vertex;
+		}
+		std::cout << std::endl;
+		return;
+	}
+	if (path.empty()) {
+		std::cout << "No path from source to destination exists." << std::endl;
+		return;
+	}
+	for (int vertex : path) {
+		vertices[vertex].setFillColor(sf::Color::Yellow);
+	}
+	vertices[path.front()].setFillColor(sf::Color::Green);
+	vertices[path.back()].setFillColor(sf::Color::Red);
+}
+
+void WeightedGraphView::Draw(sf::RenderWindow& window) {
+	for (size_t i = 0; i < edges.size(); ++i) {
+		window.draw(edges[i]);
+		window.draw(edge_weights[i]);
+	}
+	for (const auto& vertex : vertices) {
+		window.draw(vertex);
+	}
+	for (const auto& vertex_number : vertex_numbers) {
+		window.draw(vertex_number);
+	}
+	for (const auto& triangle : edge_going_to_signaling_triangles) {
+		window.draw(triangle);
+	}
+}
+
+const std::vector<sf::CircleShape>& WeightedGraphView::getVertices() const {
+	return vertices;
+}
@@ -1,13 +1,32 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <string>
+#include <cstdio>
 
 #include "../headers/MenuPage.hpp"
-int main() {
+int main(int argc, char* argv[]) {
+    // The size of the grid on the unweighted page can be given as "--grid-size WIDTHxHEIGHT"
+    int grid_width = 25;
+    int grid_height = 25;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--grid-size" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &grid_width, &grid_height) != 2 || grid_width <= 0 || grid_height <= 0) {
+                std::cerr << "Invalid grid size " << argv[i] << ", expected WIDTHxHEIGHT" << std::endl;
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Usage: PathFinder [--grid-size WIDTHxHEIGHT]" << std::endl;
+            return 1;
+        }
+    }
+
     sf::RenderWindow window(sf::VideoMode(1000, 1000), "PathFinder");
 
     MenuPage menu;
     MenuResult result = menu.Show(window);
-    UnweightedAlgorithmsPage unweighted_algorithms_page;
+    UnweightedAlgorithmsPage unweighted_algorithms_page(grid_width, grid_height);
     WeightedPage weighted_algorithms_page;
     switch (result) {
     case MenuResult::Unweighted: